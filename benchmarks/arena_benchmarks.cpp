@@ -0,0 +1,99 @@
+// Per request allocation: each request allocates a list of nodes, walks it
+// and frees every node, one at a time with new/delete, or all at once with
+// std::pmr::monotonic_buffer_resource or mp::arena.
+
+#include "benchmark_support.hpp"
+#include "marcpawl/pointers/arena.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+// NOLINTBEGIN
+
+namespace {
+
+struct node
+{
+  std::uint64_t value;
+  mp::borrower<node *> next;
+};
+
+////////////////////////////////////////////////////////////////////////////
+// Allocators
+//
+//   make(value, next)   an owner of a new node
+//   end_request(head)   frees every node of the request
+////////////////////////////////////////////////////////////////////////////
+namespace allocators {
+
+  struct new_delete
+  {
+    mp::owner<node *> make(std::uint64_t value, mp::borrower<node *> next)
+    {
+      return mp::make_owner(new node{ value, next });
+    }
+    void end_request(mp::borrower<node *> head)
+    {
+      while (head != nullptr) {
+        auto const next = head->next;
+        delete head.get();
+        head = next;
+      }
+    }
+  };
+
+  struct monotonic_buffer_resource
+  {
+    std::pmr::monotonic_buffer_resource resource;
+    mp::owner<node *> make(std::uint64_t value, mp::borrower<node *> next)
+    {
+      std::pmr::polymorphic_allocator<node> allocator{ &resource };
+      return mp::make_owner(allocator.new_object<node>(value, next));
+    }
+    void end_request(mp::borrower<node *>) { resource.release(); }
+  };
+
+  struct arena
+  {
+    mp::arena arena;
+    mp::owner<node *> make(std::uint64_t value, mp::borrower<node *> next)
+    {
+      return arena.make<node>(value, next);
+    }
+    void end_request(mp::borrower<node *>) { arena.release(); }
+  };
+
+}// namespace allocators
+
+template<class A> void BM_request(benchmark::State &state)
+{
+  auto const count = static_cast<std::uint64_t>(state.range(0));
+  A allocator;
+  for (auto _ : state) {
+    mp::borrower<node *> head{ nullptr };
+    for (std::uint64_t i = 0; i < count; ++i) {
+      head = allocator.make(i, head).as_borrower();
+    }
+    std::uint64_t sum = 0;
+    for (auto n = head; n != nullptr; n = n->next) { sum += n->value; }
+    benchmark::DoNotOptimize(sum);
+    allocator.end_request(head);
+  }
+  state.SetItemsProcessed(
+    static_cast<std::int64_t>(state.iterations() * count));
+}
+
+void request_sizes(benchmark::internal::Benchmark *b)
+{
+  b->RangeMultiplier(10)->Range(10, 100'000);
+}
+
+}// namespace
+
+BENCHMARK_TEMPLATE(BM_request, allocators::new_delete)->Apply(request_sizes);
+BENCHMARK_TEMPLATE(BM_request, allocators::monotonic_buffer_resource)
+  ->Apply(request_sizes);
+BENCHMARK_TEMPLATE(BM_request, allocators::arena)->Apply(request_sizes);
+
+// NOLINTEND
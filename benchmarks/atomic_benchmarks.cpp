@@ -0,0 +1,155 @@
+// A pointer shared by 1 to 64 threads: mostly loads, with one compare and
+// exchange in eight, as a read-mostly published configuration would see.
+// atomic_maybe_null and atomic_strict_not_null against std::atomic<T *>,
+// packed or each on its own cache line.
+
+#include "benchmark_support.hpp"
+#include "marcpawl/pointers/atomic.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// NOLINTBEGIN
+
+namespace {
+
+using bench::payload;
+
+std::array<payload, 8> payloads{
+  { { 0 }, { 1 }, { 2 }, { 3 }, { 4 }, { 5 }, { 6 }, { 7 } }
+};
+
+////////////////////////////////////////////////////////////////////////////
+// Shared pointers
+//
+//   load(a)            the value, as a raw pointer
+//   replace(a, from)   compare and exchange from the next payload
+////////////////////////////////////////////////////////////////////////////
+namespace shared {
+
+  struct raw_pointer
+  {
+    using atomic = std::atomic<payload *>;
+    static payload *load(atomic const &a)
+    {
+      return a.load(std::memory_order_acquire);
+    }
+    static void replace(atomic &a, payload *from)
+    {
+      a.compare_exchange_strong(from,
+        &payloads[(from->value + 1) % payloads.size()],
+        std::memory_order_acq_rel);
+    }
+  };
+
+  struct atomic_maybe_null
+  {
+    using atomic = mp::atomic_maybe_null<payload *>;
+    static payload *load(atomic const &a)
+    {
+      return a.load(std::memory_order_acquire)
+        .visit([](std::nullptr_t) -> payload * { return nullptr; },
+          [](mp::strict_not_null<payload *> p) -> payload * {
+            return p.get();
+          });
+    }
+    static void replace(atomic &a, payload *from)
+    {
+      mp::maybe_null<payload *> expected(from);
+      a.compare_exchange_strong(expected,
+        mp::maybe_null<payload *>(
+          &payloads[(from->value + 1) % payloads.size()]),
+        std::memory_order_acq_rel);
+    }
+  };
+
+  struct atomic_strict_not_null
+  {
+    using atomic = mp::atomic_strict_not_null<payload *>;
+    static payload *load(atomic const &a)
+    {
+      return a.load(std::memory_order_acquire).get();
+    }
+    static void replace(atomic &a, payload *from)
+    {
+      mp::strict_not_null<payload *> expected(mp::assume_not_null, from);
+      a.compare_exchange_strong(expected,
+        mp::strict_not_null<payload *>(mp::assume_not_null,
+          &payloads[(from->value + 1) % payloads.size()]),
+        std::memory_order_acq_rel);
+    }
+  };
+
+}// namespace shared
+
+template<class S> typename S::atomic make_shared()
+{
+  if constexpr (std::is_same_v<S, shared::raw_pointer>) {
+    return typename S::atomic(&payloads[0]);
+  } else if constexpr (std::is_same_v<S, shared::atomic_maybe_null>) {
+    return typename S::atomic(mp::maybe_null<payload *>(&payloads[0]));
+  } else {
+    return typename S::atomic(mp::strict_not_null(&payloads[0]));
+  }
+}
+
+// One shared pointer for every thread, or one per thread on its own cache
+// line.
+template<class S> struct alignas(mp::cache_line_size) slot
+{
+  typename S::atomic pointer = make_shared<S>();
+};
+
+constexpr std::size_t max_threads = 64;
+
+template<class S, bool Contended> void BM_shared(benchmark::State &state)
+{
+  static std::array<slot<S>, max_threads> slots;
+  auto &pointer = slots[Contended ? 0 : state.thread_index()].pointer;
+  std::uint64_t sum = 0;
+  std::uint64_t i = 0;
+  for (auto _ : state) {
+    payload *const p = S::load(pointer);
+    sum += p->value;
+    if (++i % 8 == 0) { S::replace(pointer, p); }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+template<class S> void BM_contended(benchmark::State &state)
+{
+  BM_shared<S, true>(state);
+}
+
+template<class S> void BM_uncontended(benchmark::State &state)
+{
+  BM_shared<S, false>(state);
+}
+
+}// namespace
+
+BENCHMARK_TEMPLATE(BM_contended, shared::raw_pointer)
+  ->ThreadRange(1, max_threads)
+  ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_contended, shared::atomic_maybe_null)
+  ->ThreadRange(1, max_threads)
+  ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_contended, shared::atomic_strict_not_null)
+  ->ThreadRange(1, max_threads)
+  ->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_uncontended, shared::raw_pointer)
+  ->ThreadRange(1, max_threads)
+  ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_uncontended, shared::atomic_maybe_null)
+  ->ThreadRange(1, max_threads)
+  ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_uncontended, shared::atomic_strict_not_null)
+  ->ThreadRange(1, max_threads)
+  ->UseRealTime();
+
+// NOLINTEND
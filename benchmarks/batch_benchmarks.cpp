@@ -0,0 +1,99 @@
+// Validation of an array of raw pointers, as handed over by a C API: one
+// strict_not_null at a time against as_not_null_span, which checks the
+// whole array with vector compares and keeps it in place.
+
+#include "benchmark_support.hpp"
+#include "marcpawl/pointers/batch.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <variant>
+#include <vector>
+
+// NOLINTBEGIN
+
+namespace {
+
+using bench::payload;
+
+////////////////////////////////////////////////////////////////////////////
+// Validations
+//
+//   validate(pointers)  checks every pointer, returns the number of pointers
+//                       usable afterwards
+////////////////////////////////////////////////////////////////////////////
+namespace validation {
+
+  // A plain scan, with no wrapper.
+  struct raw_pointer
+  {
+    std::size_t validate(std::span<payload *> pointers)
+    {
+      for (std::size_t i = 0; i < pointers.size(); ++i) {
+        if (pointers[i] == nullptr) { return i; }
+      }
+      return pointers.size();
+    }
+  };
+
+  // One throwing constructor per pointer, into a new array.
+  struct strict_not_null
+  {
+    std::vector<mp::strict_not_null<payload *>> checked;
+
+    std::size_t validate(std::span<payload *> pointers)
+    {
+      checked.clear();
+      for (payload *const p : pointers) { checked.emplace_back(p); }
+      return checked.size();
+    }
+  };
+
+  struct as_not_null_span
+  {
+    std::size_t validate(std::span<payload *> pointers)
+    {
+      auto const checked = mp::as_not_null_span(pointers);
+      auto const *const view =
+        std::get_if<std::span<mp::strict_not_null<payload *>>>(&checked);
+      return view == nullptr ? 0 : view->size();
+    }
+  };
+
+}// namespace validation
+
+template<class V> void BM_validate(benchmark::State &state)
+{
+  auto const count = static_cast<std::size_t>(state.range(0));
+  auto payloads = bench::make_payloads(count);
+  std::vector<payload *> pointers;
+  pointers.reserve(count);
+  for (auto &p : payloads) { pointers.push_back(&p); }
+
+  V v;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pointers.data());
+    std::size_t const valid = v.validate(pointers);
+    benchmark::DoNotOptimize(valid);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(
+    static_cast<std::int64_t>(state.iterations()) * state.range(0));
+  state.SetBytesProcessed(static_cast<std::int64_t>(
+    state.iterations() * state.range(0) * sizeof(payload *)));
+}
+
+}// namespace
+
+BENCHMARK_TEMPLATE(BM_validate, validation::raw_pointer)
+  ->RangeMultiplier(16)
+  ->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_validate, validation::strict_not_null)
+  ->RangeMultiplier(16)
+  ->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_validate, validation::as_not_null_span)
+  ->RangeMultiplier(16)
+  ->Range(1 << 10, 1 << 22);
+
+// NOLINTEND
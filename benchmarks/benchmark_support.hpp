@@ -0,0 +1,188 @@
+#pragma once
+
+#include "marcpawl/pointers/ptr.hpp"
+#include <benchmark/benchmark.h>
+#include <gsl/gsl>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// NOLINTBEGIN
+
+namespace mp = marcpawl::pointers;
+
+namespace bench {
+
+// Node counts for the traversal workloads.  Override MP_BENCHMARK_MAX_NODES
+// on machines that cannot hold the largest structures in memory.
+inline constexpr std::int64_t min_nodes = 1'000;
+#if defined(MP_BENCHMARK_MAX_NODES)
+inline constexpr std::int64_t max_nodes = MP_BENCHMARK_MAX_NODES;
+#else
+inline constexpr std::int64_t max_nodes = 100'000'000;
+#endif
+
+// Number of pointers used by the micro benchmarks.  Small enough to stay in
+// L1 so that the cost of the wrapper is not hidden by cache misses.
+inline constexpr std::size_t working_set = 1024;
+
+inline constexpr std::uint32_t seed = 0x6e756c6c;
+
+// Permutation of [0, count) so that links do not follow memory order.
+inline std::vector<std::size_t> shuffled_indices(std::size_t count)
+{
+  std::vector<std::size_t> indices(count);
+  std::iota(indices.begin(), indices.end(), std::size_t{ 0 });
+  std::mt19937_64 engine{ seed };
+  std::shuffle(indices.begin(), indices.end(), engine);
+  return indices;
+}
+
+struct payload
+{
+  std::uint64_t value = 0;
+};
+
+inline std::vector<payload> make_payloads(std::size_t count)
+{
+  std::vector<payload> payloads(count);
+  for (std::size_t i = 0; i < count; ++i) { payloads[i].value = i; }
+  return payloads;
+}
+
+// Sets the node count argument for a traversal benchmark, 1K to the limit,
+// in decades.
+inline void node_counts(benchmark::internal::Benchmark *b,
+  std::int64_t limit = max_nodes)
+{
+  b->RangeMultiplier(10)->Range(min_nodes, std::min(limit, max_nodes));
+  b->Unit(benchmark::kMicrosecond);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Pointer policies
+//
+// Every workload is written once against a policy so that each wrapper is
+// measured on exactly the same code as the raw pointer it replaces.
+//
+//   link<T>        the type stored in the data structure
+//   make(T*)       wraps a pointer that is known to be non-null
+//   get(l)         the raw pointer, for wrappers that expose one
+//   visit(l, n, v) calls n() if the link is null, v(T&) otherwise, using the
+//                  idiomatic access path for the wrapper
+//
+// `nullable` states whether the link type can represent an absent link.
+////////////////////////////////////////////////////////////////////////////
+namespace policy {
+
+  struct raw_pointer
+  {
+    static constexpr bool nullable = true;
+    template<class T> using link = T *;
+    template<class T> static link<T> make(T *ptr) { return ptr; }
+    template<class T> static link<T> null() { return nullptr; }
+    template<class T> static T *get(link<T> const &l) { return l; }
+    template<class T, class N, class V>
+    static decltype(auto) visit(link<T> const &l, N &&on_null, V &&on_value)
+    {
+      if (l == nullptr) { return on_null(); }
+      return on_value(*l);
+    }
+  };
+
+  struct unique_ptr
+  {
+    static constexpr bool nullable = true;
+    template<class T> using link = std::unique_ptr<T>;
+    template<class T> static link<T> make(T *ptr) { return link<T>(ptr); }
+    template<class T> static link<T> null() { return nullptr; }
+    template<class T> static T *get(link<T> const &l) { return l.get(); }
+    template<class T, class N, class V>
+    static decltype(auto) visit(link<T> const &l, N &&on_null, V &&on_value)
+    {
+      if (l == nullptr) { return on_null(); }
+      return on_value(*l);
+    }
+  };
+
+  struct gsl_not_null
+  {
+    static constexpr bool nullable = false;
+    template<class T> using link = gsl::not_null<T *>;
+    template<class T> static link<T> make(T *ptr) { return link<T>(ptr); }
+    template<class T> static T *get(link<T> const &l) { return l.get(); }
+    template<class T, class N, class V>
+    static decltype(auto) visit(link<T> const &l, N &&, V &&on_value)
+    {
+      return on_value(*l);
+    }
+  };
+
+  struct maybe_null
+  {
+    static constexpr bool nullable = true;
+    template<class T> using link = mp::maybe_null<T *>;
+    template<class T> static link<T> make(T *ptr) { return link<T>(ptr); }
+    template<class T> static link<T> null() { return link<T>(nullptr); }
+    template<class T, class N, class V>
+    static decltype(auto) visit(link<T> const &l, N &&on_null, V &&on_value)
+    {
+      return l.visit([&](std::nullptr_t) { return on_null(); },
+        [&](mp::strict_not_null<T *> ptr) { return on_value(*ptr); });
+    }
+  };
+
+  struct strict_not_null
+  {
+    static constexpr bool nullable = false;
+    template<class T> using link = mp::strict_not_null<T *>;
+    template<class T> static link<T> make(T *ptr) { return link<T>(ptr); }
+    template<class T> static T *get(link<T> const &l) { return l.get(); }
+    template<class T, class N, class V>
+    static decltype(auto) visit(link<T> const &l, N &&, V &&on_value)
+    {
+      return on_value(*l);
+    }
+  };
+
+  struct borrower
+  {
+    static constexpr bool nullable = true;
+    template<class T> using link = mp::borrower<T *>;
+    template<class T> static link<T> make(T *ptr) { return link<T>(ptr); }
+    template<class T> static link<T> null() { return link<T>(nullptr); }
+    template<class T> static T *get(link<T> const &l) { return l.get(); }
+    template<class T, class N, class V>
+    static decltype(auto) visit(link<T> const &l, N &&on_null, V &&on_value)
+    {
+      if (l == nullptr) { return on_null(); }
+      return on_value(*l);
+    }
+  };
+
+  struct owner
+  {
+    static constexpr bool nullable = true;
+    template<class T> using link = mp::owner<T *>;
+    template<class T> static link<T> make(T *ptr) { return link<T>(ptr); }
+    template<class T> static link<T> null() { return link<T>(nullptr); }
+    template<class T> static T *get(link<T> const &l) { return l.get(); }
+    template<class T, class N, class V>
+    static decltype(auto) visit(link<T> const &l, N &&on_null, V &&on_value)
+    {
+      if (l == nullptr) { return on_null(); }
+      return on_value(*l);
+    }
+  };
+
+}// namespace policy
+
+}// namespace bench
+
+// NOLINTEND
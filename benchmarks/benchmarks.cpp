@@ -1,13 +1,9 @@
 #include <benchmark/benchmark.h>
 
-// NOLINTBEGIN
-// cppcheck-suppress constParameterCallback
-static void BM_SomeFunction(benchmark::State& state) {
-    for (auto _ : state) {
-        // Your code to benchmark here
-    }
-}
-BENCHMARK(BM_SomeFunction);
+// The benchmarks are registered by wrapper_benchmarks.cpp and
+// traversal_benchmarks.cpp.  Compare the results against the raw pointer
+// runs with compare.py, or build the benchmark_compare target.
 
+// NOLINTBEGIN
 BENCHMARK_MAIN();
 // NOLINTEND
@@ -0,0 +1,102 @@
+// The cost of MP_BORROW_CHECKS.  The file is built into benchmarks, without
+// the checks, and into borrow_check_benchmarks, with them; compare the two
+// runs of each benchmark.
+//
+//   chase    follows borrower links through a shuffled list of owned
+//            nodes, every step is a checked operator->
+//   borrow   borrows every node from its owner, then reads through the
+//            borrower, every step copies the stamp of the owner and
+//            checks it
+
+#include "benchmark_support.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// NOLINTBEGIN
+
+namespace {
+
+struct node
+{
+  std::uint64_t value = 1;
+  mp::borrower<node *> next{ nullptr };
+};
+
+class owned_list
+{
+public:
+  explicit owned_list(std::size_t count)
+  {
+    owners_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      owners_.push_back(
+        mp::make_owner(new node{ i, mp::borrower<node *>(nullptr) }));
+    }
+    auto const order = bench::shuffled_indices(count);
+    for (std::size_t i = 0; i + 1 < count; ++i) {
+      owners_[order[i]]->next = owners_[order[i + 1]].as_borrower();
+    }
+    head_ = owners_[order[0]].as_borrower();
+  }
+
+  owned_list(owned_list const &) = delete;
+  owned_list &operator=(owned_list const &) = delete;
+
+  ~owned_list()
+  {
+    for (auto &o : owners_) { mp::delete_owned(std::move(o)); }
+  }
+
+  mp::borrower<node *> head() const { return head_; }
+  std::vector<mp::owner<node *>> const &owners() const { return owners_; }
+
+private:
+  std::vector<mp::owner<node *>> owners_;
+  mp::borrower<node *> head_{ nullptr };
+};
+
+void node_counts(benchmark::internal::Benchmark *b)
+{
+  b->RangeMultiplier(10)->Range(
+    1'000, std::min<std::int64_t>(1'000'000, bench::max_nodes));
+}
+
+void BM_borrow_check_chase(benchmark::State &state)
+{
+  owned_list const list(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (mp::borrower<node *> b = list.head();;) {
+      sum += b->value;
+      if (b->next.get() == nullptr) { break; }
+      b = b->next;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_borrow_check_borrow(benchmark::State &state)
+{
+  owned_list const list(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (auto const &o : list.owners()) {
+      mp::borrower<node *> const b(o);
+      sum += b->value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}// namespace
+
+BENCHMARK(BM_borrow_check_chase)->Apply(node_counts);
+BENCHMARK(BM_borrow_check_borrow)->Apply(node_counts);
+
+// NOLINTEND
@@ -0,0 +1,56 @@
+// A non-null pointer handed down a deep chain of calls that are not inlined,
+// which is where a wrapper that is not trivially copyable pays: it is passed
+// in memory rather than in a register at every level.
+
+#include "benchmark_support.hpp"
+
+#include <cstdint>
+
+// NOLINTBEGIN
+
+#if defined(_MSC_VER)
+#define MP_BENCHMARK_NOINLINE __declspec(noinline)
+#else
+#define MP_BENCHMARK_NOINLINE __attribute__((noinline))
+#endif
+
+namespace {
+
+using bench::payload;
+namespace policy = bench::policy;
+
+inline constexpr int chain_depth = 16;
+
+// The link is used after the nested call returns, so each level has to keep
+// it alive across a real call instead of jumping to the next level.
+template<class P, int Depth>
+MP_BENCHMARK_NOINLINE std::uint64_t call_chain(
+  typename P::template link<payload> link)
+{
+  if constexpr (Depth == 0) {
+    return P::get(link)->value;
+  } else {
+    return call_chain<P, Depth - 1>(link) + P::get(link)->value;
+  }
+}
+
+template<class P> void BM_call_chain(benchmark::State &state)
+{
+  auto payloads = bench::make_payloads(bench::working_set);
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (auto &p : payloads) { sum += call_chain<P, chain_depth>(P::make(&p)); }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(
+    state.iterations() * bench::working_set * (chain_depth + 1)));
+}
+
+}// namespace
+
+BENCHMARK_TEMPLATE(BM_call_chain, policy::raw_pointer);
+BENCHMARK_TEMPLATE(BM_call_chain, policy::gsl_not_null);
+BENCHMARK_TEMPLATE(BM_call_chain, policy::strict_not_null);
+BENCHMARK_TEMPLATE(BM_call_chain, policy::borrower);
+
+// NOLINTEND
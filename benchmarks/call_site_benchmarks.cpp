@@ -0,0 +1,77 @@
+// The cost of MP_CALL_SITE_COUNTERS.  The file is built into benchmarks,
+// without the counters, and into call_site_benchmarks, with them; compare
+// the two runs of each benchmark.
+//
+//   visit     maybe_null::visit over a working set with one null in eight
+//   check     strict_not_null constructed from raw pointers, a null check
+//   snapshot  call_site_snapshot() of the sites counted so far
+
+#include "benchmark_support.hpp"
+#include "marcpawl/pointers/call_sites.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// NOLINTBEGIN
+
+namespace {
+
+std::vector<mp::maybe_null<bench::payload *>> make_links(
+  std::vector<bench::payload> &payloads)
+{
+  std::vector<mp::maybe_null<bench::payload *>> links;
+  links.reserve(payloads.size());
+  for (std::size_t i = 0; i < payloads.size(); ++i) {
+    links.emplace_back(i % 8 == 0 ? nullptr : &payloads[i]);
+  }
+  return links;
+}
+
+void BM_call_site_visit(benchmark::State &state)
+{
+  auto payloads = bench::make_payloads(bench::working_set);
+  auto const links = make_links(payloads);
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (auto const &l : links) {
+      sum += l.visit([](std::nullptr_t) { return std::uint64_t{ 0 }; },
+        [](mp::strict_not_null<bench::payload *> p) { return p->value; });
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(
+    state.iterations() * static_cast<std::int64_t>(links.size()));
+}
+
+void BM_call_site_check(benchmark::State &state)
+{
+  auto payloads = bench::make_payloads(bench::working_set);
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (auto &p : payloads) {
+      benchmark::DoNotOptimize(&p);
+      mp::strict_not_null<bench::payload *> const checked(&p);
+      sum += checked->value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(
+    state.iterations() * static_cast<std::int64_t>(payloads.size()));
+}
+
+void BM_call_site_snapshot(benchmark::State &state)
+{
+  for (auto _ : state) {
+    auto sites = mp::call_site_snapshot();
+    benchmark::DoNotOptimize(sites.data());
+  }
+}
+
+}// namespace
+
+BENCHMARK(BM_call_site_visit);
+BENCHMARK(BM_call_site_check);
+BENCHMARK(BM_call_site_snapshot);
+
+// NOLINTEND
@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""Compare each pointer wrapper against the raw pointer it replaces.
+
+Benchmarks are named `family<policy::name>/args`.  Every run is paired with
+`family<policy::raw_pointer>/args` from the same result file and the ratio
+of their times is reported.  The comparison fails when one of the wrappers
+from ptr.hpp is slower than the raw pointer by more than the tolerance, or,
+given a baseline, when its ratio grew by more than the tolerance since the
+baseline was recorded.
+
+Ratios rather than absolute times are compared against the baseline so
+that a baseline recorded on one machine is meaningful on another.
+
+Usage:
+    compare.py [--baseline baseline.json] [--tolerance 0.10] results.json
+"""
+
+import argparse
+import json
+import re
+import sys
+
+NAME = re.compile(r"^(?P<family>[^<]+)<(?:\w+::)*(?P<policy>\w+)>(?P<args>.*)$")
+REFERENCE = "raw_pointer"
+# gsl::not_null and std::unique_ptr are reported for reference only.
+CHECKED = {"maybe_null", "strict_not_null", "borrower", "owner"}
+
+
+def load(path):
+    """Returns {(family, args): {policy: time}} using medians if present."""
+    with open(path, encoding="utf-8") as stream:
+        report = json.load(stream)
+    entries = report.get("benchmarks", [])
+    has_medians = any(e.get("aggregate_name") == "median" for e in entries)
+    results = {}
+    for entry in entries:
+        if has_medians:
+            if entry.get("aggregate_name") != "median":
+                continue
+        elif entry.get("run_type", "iteration") != "iteration":
+            continue
+        match = NAME.match(entry.get("run_name", entry["name"]))
+        if match is None:
+            continue
+        key = (match["family"], match["args"])
+        results.setdefault(key, {})[match["policy"]] = entry["real_time"]
+    return results
+
+
+def ratios(results):
+    """Returns {(family, policy, args): wrapper time / raw pointer time}."""
+    table = {}
+    for (family, args), times in results.items():
+        reference = times.get(REFERENCE)
+        if not reference:
+            continue
+        for policy, time in times.items():
+            if policy != REFERENCE:
+                table[(family, policy, args)] = time / reference
+    return table
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("results", help="google benchmark JSON output")
+    parser.add_argument("--baseline", help="checked-in baseline JSON")
+    parser.add_argument(
+        "--tolerance",
+        type=float,
+        default=0.10,
+        help="allowed slow down relative to raw pointers (default 0.10)",
+    )
+    options = parser.parse_args()
+
+    current = ratios(load(options.results))
+    baseline = ratios(load(options.baseline)) if options.baseline else {}
+    if not current:
+        print("no benchmarks paired with " + REFERENCE, file=sys.stderr)
+        return 1
+
+    failures = 0
+    print(f"{'benchmark':<56} {'ratio':>7} {'baseline':>9}  status")
+    for key in sorted(current):
+        family, policy, args = key
+        ratio = current[key]
+        previous = baseline.get(key)
+        status = "ok"
+        if policy not in CHECKED:
+            status = "reference"
+        elif ratio > 1.0 + options.tolerance:
+            status = "SLOWER THAN RAW POINTER"
+        elif previous is not None and ratio > previous + options.tolerance:
+            status = "REGRESSED"
+        if status not in ("ok", "reference"):
+            failures += 1
+        shown = f"{previous:9.3f}" if previous is not None else f"{'-':>9}"
+        print(f"{family + '<' + policy + '>' + args:<56} {ratio:7.3f} {shown}  "
+              f"{status}")
+
+    if failures:
+        print(f"\n{failures} wrapper benchmark(s) measurably slower",
+              file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
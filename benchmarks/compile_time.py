@@ -0,0 +1,255 @@
+#!/usr/bin/env python3
+"""Measure the build time of translation units that use the pointer wrappers.
+
+The same generated translation units are compiled three ways:
+
+    ptr.hpp    #include "marcpawl/pointers/ptr.hpp"
+    core.hpp   #include "marcpawl/pointers/core.hpp"
+    module     import marcpawl.pointers;
+
+Each unit declares a small linked structure and walks it with maybe_null,
+borrower and owner, so that the templates it uses are instantiated.  The
+time of every variant is reported, with the time saved against ptr.hpp.
+The module is compiled once, and that time is reported separately.
+
+With clang, -ftime-trace is passed and the time spent in the front end is
+summed from the traces as well.  A variant the compiler cannot build, e.g.
+the module with a compiler that cannot import it, is reported as such.
+
+Usage:
+    compile_time.py --compiler c++ --include DIR [--module FILE]
+                    [--count 500] [--jobs N] [--flags "-O2"] [--work DIR]
+"""
+
+import argparse
+import concurrent.futures
+import json
+import os
+import shlex
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+UNIT = """{prologue}
+
+namespace mp = marcpawl::pointers;
+
+namespace unit_{index} {{
+struct node
+{{
+  int value;
+  mp::maybe_null<node *> next;
+}};
+
+int sum(mp::maybe_null<node *> list)
+{{
+  int total = 0;
+  while (list != nullptr) {{
+    total += list.visit([](std::nullptr_t) {{ return 0; }},
+      [&](mp::strict_not_null<node *> n) {{
+        list = n->next;
+        return n->value;
+      }});
+  }}
+  return total;
+}}
+
+int second(mp::maybe_null<node *> list)
+{{
+  return list.then(&node::next)
+    .transform([](mp::strict_not_null<node *> n) {{ return n->value; }})
+    .value_or({index});
+}}
+
+int owned()
+{{
+  mp::owner<node *> owner = mp::make_owner(new node{{ {index}, {{}} }});
+  mp::borrower<node *> const view(owner);
+  int const value = view->value;
+  mp::delete_owned(std::move(owner));
+  return value;
+}}
+}}// namespace unit_{index}
+"""
+
+PROLOGUES = {
+    "ptr.hpp": '#include "marcpawl/pointers/ptr.hpp"\n#include <utility>',
+    "core.hpp": '#include "marcpawl/pointers/core.hpp"\n#include <utility>',
+    "module": "#include <cstddef>\n#include <utility>\nimport marcpawl.pointers;",
+}
+
+
+def compiler_kind(compiler):
+    """Returns "clang", "gcc" or "other"."""
+    try:
+        version = subprocess.run([compiler, "--version"], capture_output=True,
+                                 text=True, check=False).stdout
+    except OSError:
+        return "other"
+    if "clang" in version:
+        return "clang"
+    if "GCC" in version or "g++" in version or "Free Software" in version:
+        return "gcc"
+    return "other"
+
+
+def run(command, cwd):
+    """Runs a compiler command, returns (seconds, error or None)."""
+    start = time.perf_counter()
+    result = subprocess.run(command, cwd=cwd, capture_output=True, text=True,
+                            check=False)
+    elapsed = time.perf_counter() - start
+    if result.returncode != 0:
+        lines = (result.stderr or result.stdout).strip().splitlines()
+        error = next((l for l in lines if "error" in l), lines[0] if lines
+                     else "failed")
+        return elapsed, error
+    return elapsed, None
+
+
+def frontend_seconds(trace):
+    """The front end time of a clang -ftime-trace file, in seconds."""
+    try:
+        with open(trace, encoding="utf-8") as stream:
+            events = json.load(stream).get("traceEvents", [])
+    except (OSError, ValueError):
+        return 0.0
+    for event in events:
+        if event.get("name") == "Total Frontend":
+            return event.get("dur", 0) / 1e6
+    return 0.0
+
+
+def module_flags(kind, work):
+    """Flags to build and to import the module, None when unknown."""
+    if kind == "gcc":
+        return ["-fmodules-ts", "-x", "c++"], ["-fmodules-ts"]
+    if kind == "clang":
+        pcm = os.path.join(work, "marcpawl.pointers.pcm")
+        return (["--precompile", "-x", "c++-module"],
+                [f"-fmodule-file=marcpawl.pointers={pcm}"])
+    return None
+
+
+def build_module(args, kind, work):
+    """Compiles the module interface, returns (seconds, error or None)."""
+    flags = module_flags(kind, work)
+    if flags is None:
+        return 0.0, f"modules are not known for {args.compiler}"
+    build, _ = flags
+    if kind == "clang":
+        output = os.path.join(work, "marcpawl.pointers.pcm")
+    else:
+        output = os.path.join(work, "marcpawl.pointers.o")
+    command = ([args.compiler, "-std=c++20", *shlex.split(args.flags),
+                f"-I{args.include}", *build, "-c", args.module, "-o", output])
+    if kind == "clang":
+        command.remove("-c")
+    return run(command, work)
+
+
+def measure(args, kind, variant, work):
+    """Builds every unit of a variant, returns a result dictionary."""
+    directory = os.path.join(work, variant.replace(".", "_"))
+    os.makedirs(directory, exist_ok=True)
+    extra = []
+    if variant == "module":
+        extra = module_flags(kind, work)[1]
+    if kind == "clang":
+        extra.append("-ftime-trace")
+    commands = []
+    for index in range(args.count):
+        source = os.path.join(directory, f"unit_{index}.cpp")
+        with open(source, "w", encoding="utf-8") as stream:
+            stream.write(UNIT.format(prologue=PROLOGUES[variant], index=index))
+        commands.append([args.compiler, "-std=c++20", *shlex.split(args.flags),
+                         f"-I{args.include}", *extra, "-c", source, "-o",
+                         source[:-4] + ".o"])
+
+    # The module is looked up from the working directory with gcc.
+    cwd = work if variant == "module" else directory
+    elapsed, error = run(commands[0], cwd)
+    if error is not None:
+        return {"variant": variant, "error": error}
+
+    start = time.perf_counter()
+    with concurrent.futures.ThreadPoolExecutor(args.jobs) as pool:
+        results = list(pool.map(lambda c: run(c, cwd), commands[1:]))
+    wall = time.perf_counter() - start
+    errors = [e for _, e in results if e is not None]
+    if errors:
+        return {"variant": variant, "error": errors[0]}
+    cpu = elapsed + sum(seconds for seconds, _ in results)
+    frontend = None
+    if kind == "clang":
+        frontend = sum(frontend_seconds(c[-1][:-2] + ".json")
+                       for c in commands)
+    return {"variant": variant, "wall": wall, "cpu": cpu,
+            "frontend": frontend}
+
+
+def report(results, module_seconds, count):
+    """Prints the table of results."""
+    reference = next((r for r in results
+                      if r["variant"] == "ptr.hpp" and "error" not in r),
+                     None)
+    print(f"{count} translation units")
+    print(f"{'variant':<10} {'total s':>9} {'per unit ms':>12} "
+          f"{'frontend s':>11} {'saved':>7}")
+    for result in results:
+        if "error" in result:
+            print(f"{result['variant']:<10} not built: {result['error']}")
+            continue
+        frontend = ("" if result["frontend"] is None
+                    else f"{result['frontend']:.2f}")
+        saved = ""
+        if reference is not None and result is not reference:
+            saved = f"{1 - result['cpu'] / reference['cpu']:.0%}"
+        print(f"{result['variant']:<10} {result['cpu']:>9.2f} "
+              f"{1000 * result['cpu'] / count:>12.1f} {frontend:>11} "
+              f"{saved:>7}")
+    if module_seconds is not None:
+        print(f"module interface built once in {module_seconds:.2f} s")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--compiler", default=os.environ.get("CXX", "c++"))
+    parser.add_argument("--include", required=True,
+                        help="include directory of pointers_library")
+    parser.add_argument("--module", help="marcpawl.pointers.cppm")
+    parser.add_argument("--count", type=int, default=500)
+    parser.add_argument("--jobs", type=int, default=os.cpu_count() or 1)
+    parser.add_argument("--flags", default="-O2")
+    parser.add_argument("--work", help="kept directory for the sources")
+    args = parser.parse_args()
+    args.include = os.path.abspath(args.include)
+    if args.module:
+        args.module = os.path.abspath(args.module)
+
+    kind = compiler_kind(args.compiler)
+    work = args.work or tempfile.mkdtemp(prefix="compile_time_")
+    os.makedirs(work, exist_ok=True)
+    try:
+        results = [measure(args, kind, "ptr.hpp", work),
+                   measure(args, kind, "core.hpp", work)]
+        module_seconds = None
+        if args.module:
+            module_seconds, error = build_module(args, kind, work)
+            if error is None:
+                results.append(measure(args, kind, "module", work))
+            else:
+                results.append({"variant": "module", "error": error})
+                module_seconds = None
+        report(results, module_seconds, args.count)
+    finally:
+        if not args.work:
+            shutil.rmtree(work, ignore_errors=True)
+    return 1 if any("error" in r and r["variant"] != "module"
+                    for r in results) else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
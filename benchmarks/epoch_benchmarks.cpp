@@ -0,0 +1,160 @@
+// A read-mostly routing table published through an atomic pointer, read by
+// 1 to 32 threads.  Thread 0 also publishes an updated copy every
+// update_interval reads.  epoch_guard and epoch_domain::publish against
+// std::atomic<std::shared_ptr>.
+//
+// One read in sample_interval is timed, p50_ns, p99_ns and p999_ns are the
+// percentiles of those reads averaged over the threads.  They include the
+// cost of reading the clock.
+
+#include "benchmark_support.hpp"
+#include "marcpawl/pointers/epoch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// NOLINTBEGIN
+
+namespace {
+
+using table = std::unordered_map<std::uint64_t, std::uint64_t>;
+
+constexpr std::uint64_t table_size = 1024;
+constexpr std::uint64_t update_interval = 1024;
+constexpr std::uint64_t sample_interval = 16;
+constexpr int max_threads = 32;
+
+table make_table()
+{
+  table t;
+  for (std::uint64_t k = 0; k < table_size; ++k) { t.emplace(k, k); }
+  return t;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Designs
+//
+//   setup()              publishes the first table
+//   read(key)            the value of key in the current table
+//   copy()               the current table, to be updated
+//   replace(t)           publishes t, gives up the previous table
+//   teardown()           releases every table
+////////////////////////////////////////////////////////////////////////////
+namespace design {
+
+  struct epoch_based
+  {
+    struct tag;
+    using domain = mp::epoch_domain<tag>;
+    using guard = mp::epoch_guard<domain>;
+
+    static inline mp::atomic_maybe_null<table *> current;
+
+    static void setup()
+    {
+      current.store(mp::maybe_null<table *>(new table(make_table())));
+    }
+    static std::uint64_t read(std::uint64_t key)
+    {
+      guard const g;
+      return g.borrow(current)->find(key)->second;
+    }
+    static table copy()
+    {
+      guard const g;
+      return *g.borrow(current);
+    }
+    static void replace(table *t)
+    {
+      domain::publish(current, mp::owner<table *>(t));
+    }
+    static void teardown()
+    {
+      domain::publish(current, mp::owner<table *>(nullptr));
+      domain::synchronize();
+    }
+  };
+
+  struct shared_pointer
+  {
+    static inline std::atomic<std::shared_ptr<table const>> current;
+
+    static void setup()
+    {
+      current.store(std::make_shared<table>(make_table()));
+    }
+    static std::uint64_t read(std::uint64_t key)
+    {
+      std::shared_ptr<table const> const snapshot = current.load();
+      return snapshot->find(key)->second;
+    }
+    static table copy() { return *current.load(); }
+    static void replace(table *t) { current.store(std::shared_ptr<table>(t)); }
+    static void teardown() { current.store(nullptr); }
+  };
+
+}// namespace design
+
+double percentile(std::vector<std::int64_t> &samples, double p)
+{
+  if (samples.empty()) { return 0.0; }
+  auto const n = static_cast<std::size_t>(
+    p * static_cast<double>(samples.size() - 1));
+  std::nth_element(samples.begin(), samples.begin() + n, samples.end());
+  return static_cast<double>(samples[n]);
+}
+
+template<class D> void BM_reader_latency(benchmark::State &state)
+{
+  bool const writer = state.thread_index() == 0;
+  if (writer) { D::setup(); }
+  std::vector<std::int64_t> samples;
+  samples.reserve(1 << 20);
+  std::uint64_t key = static_cast<std::uint64_t>(state.thread_index());
+  std::uint64_t sum = 0;
+  std::uint64_t i = 0;
+  for (auto _ : state) {
+    key = (key * 6364136223846793005ULL + 1442695040888963407ULL);
+    std::uint64_t const k = (key >> 33) % table_size;
+    if (++i % sample_interval == 0 && samples.size() < samples.capacity()) {
+      auto const start = std::chrono::steady_clock::now();
+      sum += D::read(k);
+      samples.push_back(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count());
+    } else {
+      sum += D::read(k);
+    }
+    if (writer && i % update_interval == 0) {
+      auto *const updated = new table(D::copy());
+      ++(*updated)[i / update_interval % table_size];
+      D::replace(updated);
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  if (writer) { D::teardown(); }
+  for (auto const &[name, p] :
+    { std::pair{ "p50_ns", 0.5 }, { "p99_ns", 0.99 }, { "p999_ns", 0.999 } }) {
+    state.counters[name] = benchmark::Counter(
+      percentile(samples, p), benchmark::Counter::kAvgThreads);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+}// namespace
+
+BENCHMARK_TEMPLATE(BM_reader_latency, design::epoch_based)
+  ->ThreadRange(1, max_threads)
+  ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_reader_latency, design::shared_pointer)
+  ->ThreadRange(1, max_threads)
+  ->UseRealTime();
+
+// NOLINTEND
@@ -0,0 +1,140 @@
+// A read-mostly map published through an atomic pointer, read by 1 to 32
+// threads.  Thread 0 also replaces the map with an updated copy every
+// update_interval reads.  hazard_borrower and hazard_domain::retire against
+// std::atomic<std::shared_ptr>.
+//
+// items_per_second is the read throughput, retire_ns the average time thread
+// 0 spends publishing a copy and giving up the old one, the copy excluded.
+
+#include "benchmark_support.hpp"
+#include "marcpawl/pointers/hazard.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+// NOLINTBEGIN
+
+namespace {
+
+using map = std::unordered_map<std::uint64_t, std::uint64_t>;
+
+constexpr std::uint64_t map_size = 1024;
+constexpr std::uint64_t update_interval = 1024;
+constexpr int max_threads = 32;
+
+map make_map()
+{
+  map m;
+  for (std::uint64_t k = 0; k < map_size; ++k) { m.emplace(k, k); }
+  return m;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Designs
+//
+//   setup()              publishes the first map
+//   read(key)            the value of key in the current map
+//   replace(m)           publishes m, gives up the previous map
+//   copy()               the current map, to be updated
+//   teardown()           releases every map
+////////////////////////////////////////////////////////////////////////////
+namespace design {
+
+  struct hazard_pointer
+  {
+    struct tag;
+    using domain = mp::hazard_domain<tag>;
+
+    static inline mp::atomic_maybe_null<map *> current;
+
+    static void setup()
+    {
+      current.store(mp::maybe_null<map *>(new map(make_map())));
+    }
+    static std::uint64_t read(std::uint64_t key)
+    {
+      mp::hazard_borrower<map *, domain> const borrowed(current);
+      return borrowed->find(key)->second;
+    }
+    static map copy()
+    {
+      mp::hazard_borrower<map *, domain> const borrowed(current);
+      return *borrowed;
+    }
+    static void replace(map *m)
+    {
+      mp::maybe_null<map *> const old =
+        current.exchange(mp::maybe_null<map *>(m));
+      domain::retire(mp::owner<map *>(old.ptr_));
+    }
+    static void teardown()
+    {
+      domain::retire(
+        mp::owner<map *>(current.exchange(mp::maybe_null<map *>()).ptr_));
+      domain::reclaim();
+    }
+  };
+
+  struct shared_pointer
+  {
+    static inline std::atomic<std::shared_ptr<map const>> current;
+
+    static void setup() { current.store(std::make_shared<map>(make_map())); }
+    static std::uint64_t read(std::uint64_t key)
+    {
+      std::shared_ptr<map const> const snapshot = current.load();
+      return snapshot->find(key)->second;
+    }
+    static map copy() { return *current.load(); }
+    static void replace(map *m) { current.store(std::shared_ptr<map>(m)); }
+    static void teardown() { current.store(nullptr); }
+  };
+
+}// namespace design
+
+template<class D> void BM_read_mostly_map(benchmark::State &state)
+{
+  bool const writer = state.thread_index() == 0;
+  if (writer) { D::setup(); }
+  std::uint64_t key = static_cast<std::uint64_t>(state.thread_index());
+  std::uint64_t sum = 0;
+  std::uint64_t i = 0;
+  std::int64_t retires = 0;
+  std::chrono::nanoseconds retire_time{ 0 };
+  for (auto _ : state) {
+    key = (key * 6364136223846793005ULL + 1442695040888963407ULL);
+    sum += D::read((key >> 33) % map_size);
+    if (writer && ++i % update_interval == 0) {
+      auto *const updated = new map(D::copy());
+      ++(*updated)[i / update_interval % map_size];
+      auto const start = std::chrono::steady_clock::now();
+      D::replace(updated);
+      retire_time += std::chrono::steady_clock::now() - start;
+      ++retires;
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  if (writer) {
+    D::teardown();
+    state.counters["retire_ns"] =
+      retires == 0 ? 0.0
+                   : static_cast<double>(retire_time.count())
+                       / static_cast<double>(retires);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+}// namespace
+
+BENCHMARK_TEMPLATE(BM_read_mostly_map, design::hazard_pointer)
+  ->ThreadRange(1, max_threads)
+  ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_read_mostly_map, design::shared_pointer)
+  ->ThreadRange(1, max_threads)
+  ->UseRealTime();
+
+// NOLINTEND
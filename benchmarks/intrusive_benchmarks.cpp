@@ -0,0 +1,194 @@
+// Reference-counted handles: intrusive_ptr, with an atomic or a single
+// thread count, against std::shared_ptr, bare and in strict_not_null.
+//
+//   copy          copies a vector of handles then destroys the copy, every
+//                 handle adds a reference and drops it
+//   pass_through  hands a handle by value down a chain of calls that are
+//                 not inlined
+//   borrowed      the same chain with a borrower<T *> made once from the
+//                 handle, which never touches the count
+
+#include "benchmark_support.hpp"
+#include "marcpawl/pointers/intrusive.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// NOLINTBEGIN
+
+#if defined(_MSC_VER)
+#define MP_BENCHMARK_NOINLINE __declspec(noinline)
+#else
+#define MP_BENCHMARK_NOINLINE __attribute__((noinline))
+#endif
+
+namespace {
+
+struct plain_item
+{
+  std::uint64_t value = 1;
+};
+
+struct atomic_item : mp::ref_counted<atomic_item>
+{
+  std::uint64_t value = 1;
+};
+
+struct local_item
+  : mp::ref_counted<local_item, mp::ref_counting::single_thread>
+{
+  std::uint64_t value = 1;
+};
+
+inline constexpr int chain_depth = 16;
+
+// libstdc++ counts shared_ptr references without atomics until the process
+// starts a thread.  Start one, as a program sharing its handles would.
+[[maybe_unused]] bool const multi_threaded = [] {
+  std::thread([] {}).join();
+  return true;
+}();
+
+////////////////////////////////////////////////////////////////////////////
+// Handles
+//
+//   handle      the reference-counted type
+//   item        the object it points to
+//   make()      a handle to a new object
+//   get(h)      the raw pointer
+////////////////////////////////////////////////////////////////////////////
+namespace handle {
+
+  struct shared_ptr
+  {
+    using item = plain_item;
+    using handle = std::shared_ptr<item>;
+    static handle make() { return std::make_shared<item>(); }
+    static item *get(handle const &h) { return h.get(); }
+  };
+
+  struct not_null_shared_ptr
+  {
+    using item = plain_item;
+    using handle = mp::strict_not_null<std::shared_ptr<item>>;
+    static handle make() { return handle(std::make_shared<item>()); }
+    static item *get(handle const &h) { return h.get().get(); }
+  };
+
+  struct intrusive_ptr
+  {
+    using item = atomic_item;
+    using handle = mp::intrusive_ptr<item>;
+    static handle make() { return mp::make_intrusive<item>(); }
+    static item *get(handle const &h) { return h.get(); }
+  };
+
+  struct single_thread_intrusive_ptr
+  {
+    using item = local_item;
+    using handle = mp::intrusive_ptr<item>;
+    static handle make() { return mp::make_intrusive<item>(); }
+    static item *get(handle const &h) { return h.get(); }
+  };
+
+  struct not_null_intrusive_ptr
+  {
+    using item = atomic_item;
+    using handle = mp::strict_not_null<mp::intrusive_ptr<item>>;
+    static handle make() { return handle(mp::make_intrusive<item>()); }
+    static item *get(handle const &h) { return h.get().get(); }
+  };
+
+}// namespace handle
+
+template<class H> std::vector<typename H::handle> make_handles()
+{
+  std::vector<typename H::handle> handles;
+  handles.reserve(bench::working_set);
+  for (std::size_t i = 0; i < bench::working_set; ++i) {
+    handles.push_back(H::make());
+  }
+  return handles;
+}
+
+template<class H> void BM_copy(benchmark::State &state)
+{
+  auto const source = make_handles<H>();
+  for (auto _ : state) {
+    auto copy = source;
+    benchmark::DoNotOptimize(copy.data());
+  }
+  state.SetItemsProcessed(
+    static_cast<std::int64_t>(state.iterations() * bench::working_set));
+}
+
+// The handle is used after the nested call returns, so that each level
+// keeps its copy alive across a real call.
+template<class H, int Depth>
+MP_BENCHMARK_NOINLINE std::uint64_t pass_through(typename H::handle h)
+{
+  if constexpr (Depth == 0) {
+    return H::get(h)->value;
+  } else {
+    return pass_through<H, Depth - 1>(h) + H::get(h)->value;
+  }
+}
+
+template<class Item, int Depth>
+MP_BENCHMARK_NOINLINE std::uint64_t borrowed(mp::borrower<Item *> b)
+{
+  if constexpr (Depth == 0) {
+    return b->value;
+  } else {
+    return borrowed<Item, Depth - 1>(b) + b->value;
+  }
+}
+
+template<class H> void BM_pass_through(benchmark::State &state)
+{
+  auto const handles = make_handles<H>();
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (auto const &h : handles) { sum += pass_through<H, chain_depth>(h); }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(
+    state.iterations() * bench::working_set * (chain_depth + 1)));
+}
+
+template<class H> void BM_borrowed(benchmark::State &state)
+{
+  auto const handles = make_handles<H>();
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (auto const &h : handles) {
+      sum += borrowed<typename H::item, chain_depth>(
+        mp::borrower<typename H::item *>(H::get(h)));
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(
+    state.iterations() * bench::working_set * (chain_depth + 1)));
+}
+
+}// namespace
+
+BENCHMARK_TEMPLATE(BM_copy, handle::shared_ptr);
+BENCHMARK_TEMPLATE(BM_copy, handle::not_null_shared_ptr);
+BENCHMARK_TEMPLATE(BM_copy, handle::intrusive_ptr);
+BENCHMARK_TEMPLATE(BM_copy, handle::single_thread_intrusive_ptr);
+BENCHMARK_TEMPLATE(BM_copy, handle::not_null_intrusive_ptr);
+
+BENCHMARK_TEMPLATE(BM_pass_through, handle::shared_ptr);
+BENCHMARK_TEMPLATE(BM_pass_through, handle::not_null_shared_ptr);
+BENCHMARK_TEMPLATE(BM_pass_through, handle::intrusive_ptr);
+BENCHMARK_TEMPLATE(BM_pass_through, handle::single_thread_intrusive_ptr);
+BENCHMARK_TEMPLATE(BM_pass_through, handle::not_null_intrusive_ptr);
+
+BENCHMARK_TEMPLATE(BM_borrowed, handle::shared_ptr);
+BENCHMARK_TEMPLATE(BM_borrowed, handle::intrusive_ptr);
+
+// NOLINTEND
@@ -0,0 +1,100 @@
+// maybe_null::visit with a null_likelihood, on working sets where a given
+// share of the links is null, in per mille:
+//
+//   1    the null branch is rare, likely_not_null is the right hint
+//   500  the branch cannot be predicted, no hint is right
+//   999  the null branch is common, likely_null is the right hint
+//
+// Run with --benchmark_perf_counters=CYCLES,INSTRUCTIONS,BRANCH-MISSES
+// where Google Benchmark was built with libpfm to see the branch misses and
+// the IPC.
+
+#include "benchmark_support.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// NOLINTBEGIN
+
+namespace {
+
+constexpr std::size_t link_count = 64 * 1024;
+
+struct null_links
+{
+  explicit null_links(std::int64_t nulls_per_mille)
+    : payloads(bench::make_payloads(link_count))
+  {
+    std::mt19937_64 engine{ bench::seed };
+    std::uniform_int_distribution<std::int64_t> per_mille(0, 999);
+    links.reserve(link_count);
+    for (auto &p : payloads) {
+      links.emplace_back(
+        per_mille(engine) < nulls_per_mille ? nullptr : &p);
+    }
+  }
+
+  std::vector<bench::payload> payloads;
+  std::vector<mp::maybe_null<bench::payload *>> links;
+};
+
+template<mp::null_likelihood Likelihood>
+void BM_likelihood_visit(benchmark::State &state)
+{
+  null_links const set(state.range(0));
+  std::uint64_t missing = 0;
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (auto const &l : set.links) {
+      sum += l.template visit<Likelihood>(
+        [&missing](std::nullptr_t) {
+          ++missing;
+          return missing & 7U;
+        },
+        [](mp::strict_not_null<bench::payload *> p) { return p->value; });
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  benchmark::DoNotOptimize(missing);
+  state.SetItemsProcessed(
+    state.iterations() * static_cast<std::int64_t>(set.links.size()));
+}
+
+template<mp::null_likelihood Likelihood>
+void BM_likelihood_as_optional(benchmark::State &state)
+{
+  null_links const set(state.range(0));
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (auto const &l : set.links) {
+      auto const opt = l.template as_optional_not_null<Likelihood>();
+      if (opt.has_value()) { sum += (*opt)->value; }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(
+    state.iterations() * static_cast<std::int64_t>(set.links.size()));
+}
+
+void null_shares(benchmark::internal::Benchmark *b)
+{
+  b->Arg(1)->Arg(500)->Arg(999);
+}
+
+}// namespace
+
+BENCHMARK_TEMPLATE(BM_likelihood_visit, mp::null_likelihood::unknown)
+  ->Apply(null_shares);
+BENCHMARK_TEMPLATE(BM_likelihood_visit, mp::likely_not_null)
+  ->Apply(null_shares);
+BENCHMARK_TEMPLATE(BM_likelihood_visit, mp::likely_null)->Apply(null_shares);
+BENCHMARK_TEMPLATE(BM_likelihood_as_optional, mp::null_likelihood::unknown)
+  ->Apply(null_shares);
+BENCHMARK_TEMPLATE(BM_likelihood_as_optional, mp::likely_not_null)
+  ->Apply(null_shares);
+BENCHMARK_TEMPLATE(BM_likelihood_as_optional, mp::likely_null)
+  ->Apply(null_shares);
+
+// NOLINTEND
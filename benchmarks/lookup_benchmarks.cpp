@@ -0,0 +1,72 @@
+// Pointer identity maps, the main consumer being object caches keyed by the
+// address of the object.  Every lookup uses a raw pointer, the wrapper sets
+// rely on the transparent pointer_hash and pointer_equal so no temporary key
+// is built.
+
+#include "benchmark_support.hpp"
+
+#include <cstdint>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+// NOLINTBEGIN
+
+namespace {
+
+using bench::payload;
+namespace policy = bench::policy;
+
+template<class P>
+using pointer_set = std::conditional_t<std::is_same_v<P, policy::raw_pointer>,
+  std::unordered_set<payload *>,
+  std::unordered_set<typename P::template link<payload>,
+    mp::pointer_hash,
+    mp::pointer_equal>>;
+
+// Half of the payloads are in the set, the lookups visit all of them in
+// random order so that half of them miss.
+template<class P> void BM_pointer_lookup(benchmark::State &state)
+{
+  auto const count = static_cast<std::size_t>(state.range(0));
+  auto payloads = bench::make_payloads(2 * count);
+  pointer_set<P> set;
+  set.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    set.insert(P::make(&payloads[2 * i]));
+  }
+  std::vector<payload *> keys;
+  keys.reserve(payloads.size());
+  for (auto index : bench::shuffled_indices(payloads.size())) {
+    keys.push_back(&payloads[index]);
+  }
+
+  for (auto _ : state) {
+    std::size_t hits = 0;
+    for (payload *key : keys) { hits += set.contains(key) ? 1 : 0; }
+    benchmark::DoNotOptimize(hits);
+  }
+  state.SetItemsProcessed(
+    static_cast<std::int64_t>(state.iterations() * keys.size()));
+}
+
+// Each key costs a hash node as well as the payload, stop two orders of
+// magnitude earlier than the traversals.
+void lookup_sizes(benchmark::internal::Benchmark *b)
+{
+  bench::node_counts(b, bench::max_nodes / 100);
+}
+
+}// namespace
+
+BENCHMARK_TEMPLATE(BM_pointer_lookup, policy::raw_pointer)
+  ->Apply(lookup_sizes);
+BENCHMARK_TEMPLATE(BM_pointer_lookup, policy::gsl_not_null)
+  ->Apply(lookup_sizes);
+BENCHMARK_TEMPLATE(BM_pointer_lookup, policy::maybe_null)->Apply(lookup_sizes);
+BENCHMARK_TEMPLATE(BM_pointer_lookup, policy::strict_not_null)
+  ->Apply(lookup_sizes);
+BENCHMARK_TEMPLATE(BM_pointer_lookup, policy::borrower)->Apply(lookup_sizes);
+BENCHMARK_TEMPLATE(BM_pointer_lookup, policy::owner)->Apply(lookup_sizes);
+
+// NOLINTEND
@@ -0,0 +1,151 @@
+// Navigation through a 4 level object graph, root -> a -> b -> c -> value,
+// where every link is null one time in sixteen:
+//
+//   raw     hand-written tests of raw pointers
+//   visit   nested maybe_null::visit calls, one lambda per level
+//   chain   maybe_null::then for each link, then transform and value_or
+//
+// Each root is visited once per iteration.  The nodes of every level are
+// shuffled, so that the large graphs miss the cache at every hop.
+
+#include "benchmark_support.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// NOLINTBEGIN
+
+namespace {
+
+template<template<typename> class Link> struct graph
+{
+  struct level_c
+  {
+    std::uint64_t value;
+  };
+  struct level_b
+  {
+    Link<level_c> next;
+  };
+  struct level_a
+  {
+    Link<level_b> next;
+  };
+  struct root
+  {
+    Link<level_a> next;
+  };
+
+  explicit graph(std::size_t count)
+    : roots(count), as(count), bs(count), cs(count)
+  {
+    auto const a_order = bench::shuffled_indices(count);
+    auto const b_order = bench::shuffled_indices(count);
+    auto const c_order = bench::shuffled_indices(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      cs[c_order[i]].value = i;
+      bs[b_order[i]].next = link<level_c>(i, 1, &cs[c_order[i]]);
+      as[a_order[i]].next = link<level_b>(i, 2, &bs[b_order[i]]);
+      roots[i].next = link<level_a>(i, 3, &as[a_order[i]]);
+    }
+  }
+
+  // Null one time in sixteen, at different places for each level.
+  template<typename T>
+  static Link<T> link(std::size_t i, unsigned level, T *target)
+  {
+    bool const null =
+      (((i * 0x9e3779b97f4a7c15ULL) >> (60U - 4U * level)) & 15U) == 0;
+    return Link<T>(null ? nullptr : target);
+  }
+
+  std::vector<root> roots;
+  std::vector<level_a> as;
+  std::vector<level_b> bs;
+  std::vector<level_c> cs;
+};
+
+template<typename T> using raw_link = T *;
+template<typename T> using maybe_null_link = mp::maybe_null<T *>;
+
+using raw_graph = graph<raw_link>;
+using wrapped_graph = graph<maybe_null_link>;
+
+void BM_navigation_raw(benchmark::State &state)
+{
+  raw_graph const g(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (auto const &r : g.roots) {
+      auto const *a = r.next;
+      if (a == nullptr) { continue; }
+      auto const *b = a->next;
+      if (b == nullptr) { continue; }
+      auto const *c = b->next;
+      if (c == nullptr) { continue; }
+      sum += c->value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_navigation_visit(benchmark::State &state)
+{
+  using g_type = wrapped_graph;
+  g_type const g(static_cast<std::size_t>(state.range(0)));
+  auto const zero = [](std::nullptr_t) { return std::uint64_t{ 0 }; };
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (auto const &r : g.roots) {
+      sum += r.next.visit(zero,
+        [&](mp::strict_not_null<g_type::level_a *> a) {
+          return a->next.visit(zero,
+            [&](mp::strict_not_null<g_type::level_b *> b) {
+              return b->next.visit(zero,
+                [](mp::strict_not_null<g_type::level_c *> c) {
+                  return c->value;
+                });
+            });
+        });
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_navigation_chain(benchmark::State &state)
+{
+  using g_type = wrapped_graph;
+  g_type const g(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (auto const &r : g.roots) {
+      sum += r.next.then(&g_type::level_a::next)
+               .then(&g_type::level_b::next)
+               .transform([](mp::strict_not_null<g_type::level_c *> c) {
+                 return c->value;
+               })
+               .value_or(0);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void graph_sizes(benchmark::internal::Benchmark *b)
+{
+  b->RangeMultiplier(100)->Range(
+    1'000, std::min<std::int64_t>(1'000'000, bench::max_nodes));
+  b->Unit(benchmark::kMicrosecond);
+}
+
+}// namespace
+
+BENCHMARK(BM_navigation_raw)->Apply(graph_sizes);
+BENCHMARK(BM_navigation_visit)->Apply(graph_sizes);
+BENCHMARK(BM_navigation_chain)->Apply(graph_sizes);
+
+// NOLINTEND
@@ -0,0 +1,112 @@
+// optional_not_null<T *>, null as the empty state, against
+// std::optional<strict_not_null<T *>> and a raw pointer:
+//
+//   return     a lookup, kept out of line, returns the result by value,
+//              with one miss in eight
+//   footprint  sums a vector of results; bytes_per_item is the size of an
+//              element
+//
+// The std::optional is two words and is returned through memory, the
+// other two are one word returned in a register.
+
+#include "benchmark_support.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// NOLINTBEGIN
+
+namespace {
+
+using bench::payload;
+
+struct raw_result
+{
+  using type = payload *;
+  static type found(payload *p) { return p; }
+  static type missing() { return nullptr; }
+  static std::uint64_t value(type r) { return r == nullptr ? 0 : r->value; }
+};
+
+struct niche_result
+{
+  using type = mp::optional_not_null<payload *>;
+  static type found(payload *p)
+  {
+    return mp::strict_not_null<payload *>(mp::assume_not_null, p);
+  }
+  static type missing() { return std::nullopt; }
+  static std::uint64_t value(type r) { return r ? (*r)->value : 0; }
+};
+
+struct std_optional_result
+{
+  using type = std::optional<mp::strict_not_null<payload *>>;
+  static type found(payload *p)
+  {
+    return mp::strict_not_null<payload *>(mp::assume_not_null, p);
+  }
+  static type missing() { return std::nullopt; }
+  static std::uint64_t value(type r) { return r ? (*r)->value : 0; }
+};
+
+template<class R>
+[[gnu::noinline]] typename R::type lookup(std::vector<payload> &payloads,
+  std::size_t i)
+{
+  if (i % 8 == 0) { return R::missing(); }
+  return R::found(&payloads[i]);
+}
+
+template<class R> void BM_optional_return(benchmark::State &state)
+{
+  auto payloads = bench::make_payloads(bench::working_set);
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < payloads.size(); ++i) {
+      sum += R::value(lookup<R>(payloads, i));
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(
+    state.iterations() * static_cast<std::int64_t>(payloads.size()));
+}
+
+template<class R> void BM_optional_footprint(benchmark::State &state)
+{
+  auto const count = static_cast<std::size_t>(state.range(0));
+  auto payloads = bench::make_payloads(count);
+  std::vector<typename R::type> results;
+  results.reserve(count);
+  for (auto const i : bench::shuffled_indices(count)) {
+    results.push_back(i % 8 == 0 ? R::missing() : R::found(&payloads[i]));
+  }
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (auto const &r : results) { sum += R::value(r); }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["bytes_per_item"] =
+    static_cast<double>(sizeof(typename R::type));
+}
+
+void result_counts(benchmark::internal::Benchmark *b)
+{
+  b->RangeMultiplier(10)->Range(
+    1'000, std::min<std::int64_t>(1'000'000, bench::max_nodes));
+}
+
+}// namespace
+
+BENCHMARK_TEMPLATE(BM_optional_return, raw_result);
+BENCHMARK_TEMPLATE(BM_optional_return, niche_result);
+BENCHMARK_TEMPLATE(BM_optional_return, std_optional_result);
+BENCHMARK_TEMPLATE(BM_optional_footprint, raw_result)->Apply(result_counts);
+BENCHMARK_TEMPLATE(BM_optional_footprint, niche_result)->Apply(result_counts);
+BENCHMARK_TEMPLATE(BM_optional_footprint, std_optional_result)
+  ->Apply(result_counts);
+
+// NOLINTEND
@@ -0,0 +1,202 @@
+// Identity sets of pointers: pointer_set against std::unordered_set<T*> and,
+// when abseil is available, absl::flat_hash_set<T*>.  Every operation is
+// measured from 1K to 50M keys, inserted and looked up in random order.
+//
+// find_strided looks up keys 1 KiB apart, e.g. the headers of pages, whose
+// addresses differ only above their low 10 bits.
+
+#include "benchmark_support.hpp"
+#include "marcpawl/pointers/pointer_set.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#if defined(MP_BENCHMARK_HAVE_ABSL)
+#include <absl/container/flat_hash_set.h>
+#endif
+
+// NOLINTBEGIN
+
+namespace {
+
+using bench::payload;
+
+////////////////////////////////////////////////////////////////////////////
+// Sets under test
+//
+//   type        the set of payload pointers
+//   key(p)      the key inserted for the payload pointer p
+////////////////////////////////////////////////////////////////////////////
+namespace sets {
+
+  struct unordered_set
+  {
+    using type = std::unordered_set<payload *>;
+    static payload *key(payload *p) { return p; }
+  };
+
+#if defined(MP_BENCHMARK_HAVE_ABSL)
+  struct flat_hash_set
+  {
+    using type = absl::flat_hash_set<payload *>;
+    static payload *key(payload *p) { return p; }
+  };
+#endif
+
+  struct pointer_set_borrower
+  {
+    using type = mp::pointer_set<mp::borrower<payload *>>;
+    static mp::borrower<payload *> key(payload *p)
+    {
+      return mp::borrower<payload *>(p);
+    }
+  };
+
+  struct pointer_set_strict_not_null
+  {
+    using type = mp::pointer_set<mp::strict_not_null<payload *>>;
+    static mp::strict_not_null<payload *> key(payload *p)
+    {
+      return mp::strict_not_null<payload *>(p);
+    }
+  };
+
+}// namespace sets
+
+// Twice as many payloads as keys, the keys are the even ones so that half
+// of the lookups miss.
+struct fixture
+{
+  explicit fixture(std::size_t count)
+    : payloads(bench::make_payloads(2 * count))
+  {
+    for (auto index : bench::shuffled_indices(count)) {
+      keys.push_back(&payloads[2 * index]);
+    }
+    for (auto index : bench::shuffled_indices(payloads.size())) {
+      lookups.push_back(&payloads[index]);
+    }
+  }
+
+  template<class S> typename S::type make_set() const
+  {
+    typename S::type set;
+    for (payload *p : keys) { set.insert(S::key(p)); }
+    return set;
+  }
+
+  std::vector<payload> payloads;
+  std::vector<payload *> keys;
+  std::vector<payload *> lookups;
+};
+
+template<class S> void BM_set_insert(benchmark::State &state)
+{
+  fixture const f(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto set = f.make_set<S>();
+    benchmark::DoNotOptimize(set);
+  }
+  state.SetItemsProcessed(
+    static_cast<std::int64_t>(state.iterations() * f.keys.size()));
+}
+
+template<class S> void BM_set_find(benchmark::State &state)
+{
+  fixture const f(static_cast<std::size_t>(state.range(0)));
+  auto const set = f.make_set<S>();
+  for (auto _ : state) {
+    std::size_t hits = 0;
+    for (payload *p : f.lookups) { hits += set.contains(p) ? 1 : 0; }
+    benchmark::DoNotOptimize(hits);
+  }
+  state.SetItemsProcessed(
+    static_cast<std::int64_t>(state.iterations() * f.lookups.size()));
+}
+
+template<class S> void BM_set_erase(benchmark::State &state)
+{
+  fixture const f(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto set = f.make_set<S>();
+    state.ResumeTiming();
+    for (payload *p : f.keys) { set.erase(p); }
+    benchmark::DoNotOptimize(set);
+  }
+  state.SetItemsProcessed(
+    static_cast<std::int64_t>(state.iterations() * f.keys.size()));
+}
+
+template<class S> void BM_set_iterate(benchmark::State &state)
+{
+  fixture const f(static_cast<std::size_t>(state.range(0)));
+  auto const set = f.make_set<S>();
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (auto const &key : set) { sum += key->value; }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(
+    static_cast<std::int64_t>(state.iterations() * f.keys.size()));
+}
+
+void set_sizes(benchmark::internal::Benchmark *b)
+{
+  bench::node_counts(b, 50'000'000);
+}
+
+struct page
+{
+  std::uint64_t value = 1;
+  std::byte data[1016];
+};
+
+template<class Set> void BM_set_find_strided(benchmark::State &state)
+{
+  std::vector<page> pages(static_cast<std::size_t>(state.range(0)));
+  Set set;
+  for (auto index : bench::shuffled_indices(pages.size() / 2)) {
+    set.insert(typename Set::value_type(&pages[2 * index]));
+  }
+  std::vector<page *> lookups;
+  for (auto index : bench::shuffled_indices(pages.size())) {
+    lookups.push_back(&pages[index]);
+  }
+  for (auto _ : state) {
+    std::size_t hits = 0;
+    for (page *p : lookups) { hits += set.contains(p) ? 1 : 0; }
+    benchmark::DoNotOptimize(hits);
+  }
+  state.SetItemsProcessed(
+    static_cast<std::int64_t>(state.iterations() * lookups.size()));
+}
+
+void strided_sizes(benchmark::internal::Benchmark *b)
+{
+  bench::node_counts(b, 1'000'000);
+}
+
+}// namespace
+
+#define MP_SET_BENCHMARKS(S)                                                 \
+  BENCHMARK_TEMPLATE(BM_set_insert, sets::S)->Apply(set_sizes);              \
+  BENCHMARK_TEMPLATE(BM_set_find, sets::S)->Apply(set_sizes);                \
+  BENCHMARK_TEMPLATE(BM_set_erase, sets::S)->Apply(set_sizes);               \
+  BENCHMARK_TEMPLATE(BM_set_iterate, sets::S)->Apply(set_sizes)
+
+MP_SET_BENCHMARKS(unordered_set);
+#if defined(MP_BENCHMARK_HAVE_ABSL)
+MP_SET_BENCHMARKS(flat_hash_set);
+#endif
+MP_SET_BENCHMARKS(pointer_set_borrower);
+MP_SET_BENCHMARKS(pointer_set_strict_not_null);
+
+BENCHMARK_TEMPLATE(BM_set_find_strided, std::unordered_set<page *>)
+  ->Apply(strided_sizes);
+BENCHMARK_TEMPLATE(BM_set_find_strided, mp::pointer_set<mp::borrower<page *>>)
+  ->Apply(strided_sizes);
+
+// NOLINTEND
@@ -0,0 +1,94 @@
+// Acquire/release throughput of size_class_pool against malloc/free, from 1
+// to 64 threads.  Each thread holds a batch of objects at a time, so that
+// objects go through the thread caches and, past a batch, the shared lists.
+
+#include "benchmark_support.hpp"
+#include "marcpawl/pointers/pool.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <vector>
+
+// NOLINTBEGIN
+
+namespace {
+
+struct node
+{
+  std::uint64_t value;
+  std::uint64_t next;
+  std::uint64_t left;
+  std::uint64_t right;
+};
+
+inline constexpr std::size_t held = 100;
+
+////////////////////////////////////////////////////////////////////////////
+// Allocators
+//
+//   handle          what acquire() returns
+//   acquire(v)      a node with the value v
+//   value(h)        the value of the node
+//   release(h)      frees the node
+////////////////////////////////////////////////////////////////////////////
+namespace allocators {
+
+  struct malloc_free
+  {
+    using handle = node *;
+    static handle acquire(std::uint64_t v)
+    {
+      void *const memory = std::malloc(sizeof(node));
+      if (memory == nullptr) { throw std::bad_alloc(); }
+      return ::new (memory) node{ v, 0, 0, 0 };
+    }
+    static std::uint64_t value(handle const &h) { return h->value; }
+    static void release(handle h) { std::free(h); }
+  };
+
+  struct size_class_pool
+  {
+    using pool = mp::size_class_pool<>;
+    using handle = pool::handle<node>;
+    static handle acquire(std::uint64_t v)
+    {
+      std::uint64_t const zero = 0;
+      return pool::acquire<node>(v, zero, zero, zero);
+    }
+    static std::uint64_t value(handle const &h) { return h->value; }
+    static void release(handle h) { pool::release(std::move(h)); }
+  };
+
+}// namespace allocators
+
+template<class A> void BM_acquire_release(benchmark::State &state)
+{
+  // A vector since a strict_not_null handle has no default value.
+  std::vector<typename A::handle> handles;
+  handles.reserve(held);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < held; ++i) {
+      handles.push_back(A::acquire(i));
+    }
+    std::uint64_t sum = 0;
+    for (auto const &h : handles) { sum += A::value(h); }
+    benchmark::DoNotOptimize(sum);
+    for (auto &h : handles) { A::release(std::move(h)); }
+    handles.clear();
+  }
+  state.SetItemsProcessed(
+    static_cast<std::int64_t>(state.iterations() * held));
+}
+
+}// namespace
+
+BENCHMARK_TEMPLATE(BM_acquire_release, allocators::malloc_free)
+  ->ThreadRange(1, 64)
+  ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_acquire_release, allocators::size_class_pool)
+  ->ThreadRange(1, 64)
+  ->UseRealTime();
+
+// NOLINTEND
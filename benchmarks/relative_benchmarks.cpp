@@ -0,0 +1,446 @@
+// Breadth and depth first searches over a graph of out degree 8, up to 50M
+// edges, with 64 bit pointers for edges or with 32 bit relative ones.  The
+// nodes and the edges share one arena, so that every edge reaches its
+// target within 32 bits.  The edge array is half the size with relative
+// pointers, see the edge_bytes counter.
+//
+// Also compares loading a tree of self_relative pointers, up to 1 GiB, by
+// mapping its file with rebuilding a tree of raw pointers from a file of
+// indices.  Both include one traversal, so that the page faults of the
+// mapping are counted.  The files are in the page cache after the first
+// iteration.
+
+#include "benchmark_support.hpp"
+#include "marcpawl/pointers/relative.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define MP_BENCHMARK_HAVE_MMAP
+#endif
+
+// NOLINTBEGIN
+
+namespace {
+
+using bench::payload;
+
+// The arena of the graph being searched, for offset_ptr.
+struct current_arena
+{
+  static inline void const *address = nullptr;
+  static void const *base() noexcept { return address; }
+};
+
+////////////////////////////////////////////////////////////////////////////
+// Edge types
+//
+//   type           the edge stored in the adjacency lists
+//   target(e)      the node the edge points to
+////////////////////////////////////////////////////////////////////////////
+namespace edges {
+
+  struct raw_pointer
+  {
+    using type = payload *;
+    static payload *target(type const &e) { return e; }
+  };
+
+  struct borrower
+  {
+    using type = mp::borrower<payload *>;
+    static payload *target(type const &e) { return e.get(); }
+  };
+
+  struct compressed_borrower
+  {
+    using type = mp::borrower<mp::compressed_ptr<payload>>;
+    static payload *target(type const &e) { return e.get().get(); }
+  };
+
+  struct offset_borrower
+  {
+    using type = mp::borrower<mp::offset_ptr<payload, current_arena>>;
+    static payload *target(type const &e) { return e.get().get(); }
+  };
+
+}// namespace edges
+
+inline constexpr std::size_t out_degree = 8;
+
+// Nodes followed by their adjacency lists, in one allocation.  The edges
+// are built in place since a self relative pointer is relative to where it
+// is stored.
+template<class E> class graph
+{
+public:
+  using edge = typename E::type;
+
+  explicit graph(std::size_t count)
+    : count_(count),
+      edges_offset_(
+        (count * sizeof(payload) + alignof(edge) - 1) / alignof(edge)
+        * alignof(edge)),
+      storage_(new std::byte[edges_offset_ + edge_count() * sizeof(edge)])
+  {
+    current_arena::address = storage_.get();
+    auto *const n = nodes();
+    for (std::size_t i = 0; i < count; ++i) {
+      new (&n[i]) payload{ i };
+    }
+    auto const targets = bench::shuffled_indices(count);
+    auto *const e = edges();
+    for (std::size_t i = 0; i < edge_count(); ++i) {
+      new (&e[i]) edge(&n[targets[i % count]]);
+    }
+  }
+
+  graph(graph const &) = delete;
+  graph &operator=(graph const &) = delete;
+
+  ~graph() { std::destroy_n(edges(), edge_count()); }
+
+  std::size_t count() const { return count_; }
+  std::size_t edge_count() const { return count_ * out_degree; }
+
+  payload *nodes() const
+  {
+    return std::launder(reinterpret_cast<payload *>(storage_.get()));
+  }
+
+  edge *edges() const
+  {
+    return std::launder(
+      reinterpret_cast<edge *>(storage_.get() + edges_offset_));
+  }
+
+  std::size_t index(payload const *node) const
+  {
+    return static_cast<std::size_t>(node - nodes());
+  }
+
+private:
+  std::size_t count_;
+  std::size_t edges_offset_;
+  std::unique_ptr<std::byte[]> storage_;
+};
+
+// Sums the values of the nodes reachable from the first one, in breadth
+// first order.
+template<class E>
+std::uint64_t breadth_first(graph<E> const &g,
+  std::vector<std::uint8_t> &visited,
+  std::vector<payload const *> &queue)
+{
+  visited.assign(g.count(), 0);
+  queue.clear();
+  queue.push_back(g.nodes());
+  visited[0] = 1;
+  std::uint64_t sum = 0;
+  for (std::size_t head = 0; head < queue.size(); ++head) {
+    payload const *const node = queue[head];
+    sum += node->value;
+    auto const *const first = g.edges() + g.index(node) * out_degree;
+    for (auto const *e = first; e != first + out_degree; ++e) {
+      payload const *const target = E::target(*e);
+      auto &seen = visited[g.index(target)];
+      if (seen == 0) {
+        seen = 1;
+        queue.push_back(target);
+      }
+    }
+  }
+  return sum;
+}
+
+// Same, in depth first order with an explicit stack.
+template<class E>
+std::uint64_t depth_first(graph<E> const &g,
+  std::vector<std::uint8_t> &visited,
+  std::vector<payload const *> &stack)
+{
+  visited.assign(g.count(), 0);
+  stack.clear();
+  stack.push_back(g.nodes());
+  visited[0] = 1;
+  std::uint64_t sum = 0;
+  while (!stack.empty()) {
+    payload const *const node = stack.back();
+    stack.pop_back();
+    sum += node->value;
+    auto const *const first = g.edges() + g.index(node) * out_degree;
+    for (auto const *e = first; e != first + out_degree; ++e) {
+      payload const *const target = E::target(*e);
+      auto &seen = visited[g.index(target)];
+      if (seen == 0) {
+        seen = 1;
+        stack.push_back(target);
+      }
+    }
+  }
+  return sum;
+}
+
+template<class E> void set_counters(benchmark::State &state, graph<E> const &g)
+{
+  state.SetItemsProcessed(
+    static_cast<std::int64_t>(state.iterations() * g.edge_count()));
+  state.counters["edge_bytes"] = benchmark::Counter(
+    static_cast<double>(sizeof(typename E::type) * g.edge_count()),
+    benchmark::Counter::kDefaults,
+    benchmark::Counter::kIs1024);
+}
+
+template<class E> void BM_graph_bfs(benchmark::State &state)
+{
+  graph<E> const g(static_cast<std::size_t>(state.range(0)));
+  std::vector<std::uint8_t> visited;
+  std::vector<payload const *> queue;
+  queue.reserve(g.count());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(breadth_first(g, visited, queue));
+  }
+  set_counters(state, g);
+}
+
+template<class E> void BM_graph_dfs(benchmark::State &state)
+{
+  graph<E> const g(static_cast<std::size_t>(state.range(0)));
+  std::vector<std::uint8_t> visited;
+  std::vector<payload const *> stack;
+  stack.reserve(g.edge_count());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(depth_first(g, visited, stack));
+  }
+  set_counters(state, g);
+}
+
+// Node counts, up to 50M edges.
+void graph_sizes(benchmark::internal::Benchmark *b)
+{
+  bench::node_counts(
+    b, static_cast<std::int64_t>(50'000'000 / out_degree));
+}
+
+#if defined(MP_BENCHMARK_HAVE_MMAP)
+
+////////////////////////////////////////////////////////////////////////////
+// Persisted trees
+//
+// A complete binary tree, node i has the children 2i+1 and 2i+2, stored
+// either as nodes of self_relative pointers that are usable as mapped, or
+// as child indices that have to be turned into pointers after reading.
+////////////////////////////////////////////////////////////////////////////
+namespace persisted {
+
+  struct node
+  {
+    mp::maybe_null<mp::self_relative<node>> left;
+    mp::maybe_null<mp::self_relative<node>> right;
+    std::uint64_t value;
+  };
+
+  std::uint64_t sum(mp::maybe_null<mp::self_relative<node>> const &n)
+  {
+    return n.visit([](std::nullptr_t) { return std::uint64_t{ 0 }; },
+      [](mp::strict_not_null<node *> p) {
+        return p->value + sum(p->left) + sum(p->right);
+      });
+  }
+
+  struct indexed_node
+  {
+    std::uint64_t left;
+    std::uint64_t right;
+    std::uint64_t value;
+  };
+
+  inline constexpr std::uint64_t no_child = ~std::uint64_t{ 0 };
+
+  struct raw_node
+  {
+    raw_node *left;
+    raw_node *right;
+    std::uint64_t value;
+  };
+
+  std::uint64_t sum(raw_node const *n)
+  {
+    if (n == nullptr) { return 0; }
+    return n->value + sum(n->left) + sum(n->right);
+  }
+
+  // Writes count elements made by make(i, element *) to a temporary file,
+  // removed when the file goes out of scope.  written() is false when the
+  // file could not be written in full.
+  class file
+  {
+  public:
+    template<class T, class Make>
+    file(std::in_place_type_t<T>,
+      std::string const &name,
+      std::size_t count,
+      Make make)
+      : path_(std::filesystem::temp_directory_path() / name),
+        size_(count * sizeof(T))
+    {
+      std::vector<T> elements(count);
+      for (std::size_t i = 0; i < count; ++i) { make(i, elements.data()); }
+      std::FILE *const out = std::fopen(path_.c_str(), "wb");
+      if (out == nullptr) { return; }
+      bool const complete =
+        std::fwrite(elements.data(), sizeof(T), count, out) == count;
+      written_ = std::fclose(out) == 0 && complete;
+    }
+
+    file(file const &) = delete;
+    file &operator=(file const &) = delete;
+    ~file() { std::filesystem::remove(path_); }
+
+    std::filesystem::path const &path() const { return path_; }
+    std::size_t size() const { return size_; }
+    bool written() const { return written_; }
+
+  private:
+    std::filesystem::path path_;
+    std::size_t size_;
+    bool written_ = false;
+  };
+
+  std::uint64_t child(std::size_t i, std::size_t count)
+  {
+    return i < count ? i : no_child;
+  }
+
+}// namespace persisted
+
+void BM_tree_load_mapped(benchmark::State &state)
+{
+  using persisted::node;
+  auto const count = static_cast<std::size_t>(state.range(0));
+  persisted::file const f{ std::in_place_type<node>,
+    "marcpawl_pointers_mapped_tree.bin",
+    count,
+    [count](std::size_t i, node *nodes) {
+      nodes[i].value = i;
+      if (2 * i + 1 < count) {
+        nodes[i].left =
+          mp::maybe_null<mp::self_relative<node>>{ &nodes[2 * i + 1] };
+      }
+      if (2 * i + 2 < count) {
+        nodes[i].right =
+          mp::maybe_null<mp::self_relative<node>>{ &nodes[2 * i + 2] };
+      }
+    } };
+  if (!f.written()) {
+    state.SkipWithError("cannot write the tree file");
+    return;
+  }
+
+  for (auto _ : state) {
+    int const fd = ::open(f.path().c_str(), O_RDONLY);
+    if (fd < 0) {
+      state.SkipWithError("cannot open the tree file");
+      return;
+    }
+    void *const mapped =
+      ::mmap(nullptr, f.size(), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+      state.SkipWithError("mmap failed");
+      return;
+    }
+    auto const *root = static_cast<node const *>(mapped);
+    benchmark::DoNotOptimize(
+      root->value + persisted::sum(root->left) + persisted::sum(root->right));
+    ::munmap(mapped, f.size());
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+  state.SetBytesProcessed(
+    static_cast<std::int64_t>(state.iterations() * f.size()));
+}
+
+void BM_tree_rebuild(benchmark::State &state)
+{
+  using persisted::indexed_node;
+  using persisted::raw_node;
+  auto const count = static_cast<std::size_t>(state.range(0));
+  persisted::file const f{ std::in_place_type<indexed_node>,
+    "marcpawl_pointers_indexed_tree.bin",
+    count,
+    [count](std::size_t i, indexed_node *nodes) {
+      nodes[i] = { persisted::child(2 * i + 1, count),
+        persisted::child(2 * i + 2, count),
+        i };
+    } };
+  if (!f.written()) {
+    state.SkipWithError("cannot write the tree file");
+    return;
+  }
+
+  std::vector<indexed_node> buffer(count);
+  for (auto _ : state) {
+    std::FILE *const in = std::fopen(f.path().c_str(), "rb");
+    if (in == nullptr) {
+      state.SkipWithError("cannot open the tree file");
+      return;
+    }
+    auto const read = std::fread(buffer.data(), sizeof(indexed_node), count, in);
+    if (std::fclose(in) != 0 || read != count) {
+      state.SkipWithError("short read");
+      return;
+    }
+    std::vector<raw_node> nodes(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      auto const &from = buffer[i];
+      nodes[i] = { from.left == persisted::no_child ? nullptr : &nodes[from.left],
+        from.right == persisted::no_child ? nullptr : &nodes[from.right],
+        from.value };
+    }
+    benchmark::DoNotOptimize(persisted::sum(nodes.data()));
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+  state.SetBytesProcessed(
+    static_cast<std::int64_t>(state.iterations() * f.size()));
+}
+
+// Node counts, up to 1 GiB of nodes.
+void tree_sizes(benchmark::internal::Benchmark *b)
+{
+  bench::node_counts(
+    b, static_cast<std::int64_t>((std::size_t{ 1 } << 30) / sizeof(persisted::node)));
+}
+
+#endif
+
+}// namespace
+
+BENCHMARK_TEMPLATE(BM_graph_bfs, edges::raw_pointer)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(BM_graph_bfs, edges::borrower)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(BM_graph_bfs, edges::compressed_borrower)
+  ->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(BM_graph_bfs, edges::offset_borrower)->Apply(graph_sizes);
+
+BENCHMARK_TEMPLATE(BM_graph_dfs, edges::raw_pointer)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(BM_graph_dfs, edges::borrower)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(BM_graph_dfs, edges::compressed_borrower)
+  ->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(BM_graph_dfs, edges::offset_borrower)->Apply(graph_sizes);
+
+#if defined(MP_BENCHMARK_HAVE_MMAP)
+BENCHMARK(BM_tree_load_mapped)->Apply(tree_sizes);
+BENCHMARK(BM_tree_rebuild)->Apply(tree_sizes);
+#endif
+
+// NOLINTEND
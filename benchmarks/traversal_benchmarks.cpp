@@ -0,0 +1,233 @@
+// Pointer chasing workloads: a linked list, a binary tree and a graph stored
+// as adjacency lists, each built once per size with every pointer type.
+
+#include "benchmark_support.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// NOLINTBEGIN
+
+namespace {
+
+namespace policy = bench::policy;
+
+// Storage for `count` nodes whose addresses are known before the nodes are
+// constructed, so that links to nodes that are not built yet can be made
+// without reassigning them.
+template<class Node> class node_storage
+{
+public:
+  explicit node_storage(std::size_t count)
+    : count_(count), nodes_(allocator_.allocate(count))
+  {}
+
+  node_storage(node_storage const &) = delete;
+  node_storage &operator=(node_storage const &) = delete;
+
+  ~node_storage()
+  {
+    for (std::size_t i = 0; i < constructed_; ++i) {
+      std::destroy_at(nodes_ + i);
+    }
+    allocator_.deallocate(nodes_, count_);
+  }
+
+  Node *address(std::size_t index) const { return nodes_ + index; }
+
+  template<class... Args> void emplace_back(Args &&...args)
+  {
+    std::construct_at(nodes_ + constructed_, std::forward<Args>(args)...);
+    ++constructed_;
+  }
+
+private:
+  std::allocator<Node> allocator_;
+  std::size_t count_;
+  std::size_t constructed_ = 0;
+  Node *nodes_;
+};
+
+////////////////////////////////////////////////////////////////////////////
+// Circular singly linked list, links in random memory order.
+////////////////////////////////////////////////////////////////////////////
+template<class P> struct list_node
+{
+  typename P::template link<list_node> next;
+  std::uint64_t value;
+};
+
+template<class P> void BM_list_traversal(benchmark::State &state)
+{
+  using node = list_node<P>;
+  auto const count = static_cast<std::size_t>(state.range(0));
+  auto const order = bench::shuffled_indices(count);
+  std::vector<std::size_t> successor(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    successor[order[i]] = order[(i + 1) % count];
+  }
+  node_storage<node> nodes(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    nodes.emplace_back(P::make(nodes.address(successor[i])), i);
+  }
+
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    node const *current = nodes.address(0);
+    for (std::size_t i = 0; i < count; ++i) {
+      sum += current->value;
+      current = P::visit(
+        current->next,
+        []() -> node const * { return nullptr; },
+        [](node const &next) { return &next; });
+    }
+    benchmark::DoNotOptimize(sum);
+    benchmark::DoNotOptimize(current);
+  }
+  state.SetItemsProcessed(
+    static_cast<std::int64_t>(state.iterations() * count));
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Complete binary tree with null leaves, nodes allocated one at a time in
+// random order.  unique_ptr owns its children, the other policies leave
+// ownership with the benchmark.
+////////////////////////////////////////////////////////////////////////////
+template<class P> struct tree_node
+{
+  typename P::template link<tree_node> left = P::template null<tree_node>();
+  typename P::template link<tree_node> right = P::template null<tree_node>();
+  std::uint64_t value = 0;
+};
+
+template<class P> class tree
+{
+public:
+  using node = tree_node<P>;
+
+  explicit tree(std::size_t count) : nodes_(count, nullptr)
+  {
+    for (auto index : bench::shuffled_indices(count)) {
+      nodes_[index] = new node;
+      nodes_[index]->value = index;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+      if (2 * i + 1 < count) { nodes_[i]->left = P::make(nodes_[2 * i + 1]); }
+      if (2 * i + 2 < count) { nodes_[i]->right = P::make(nodes_[2 * i + 2]); }
+    }
+  }
+
+  tree(tree const &) = delete;
+  tree &operator=(tree const &) = delete;
+
+  ~tree()
+  {
+    if constexpr (std::is_same_v<P, policy::unique_ptr>) {
+      delete nodes_.front();
+    } else {
+      for (node *n : nodes_) { delete n; }
+    }
+  }
+
+  node const &root() const { return *nodes_.front(); }
+
+private:
+  std::vector<node *> nodes_;
+};
+
+template<class P> std::uint64_t tree_sum(tree_node<P> const &n)
+{
+  auto const none = []() { return std::uint64_t{ 0 }; };
+  auto const child = [](tree_node<P> const &c) { return tree_sum(c); };
+  return n.value + P::visit(n.left, none, child)
+         + P::visit(n.right, none, child);
+}
+
+template<class P> void BM_tree_traversal(benchmark::State &state)
+{
+  auto const count = static_cast<std::size_t>(state.range(0));
+  tree<P> const t(count);
+  for (auto _ : state) {
+    auto sum = tree_sum(t.root());
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(
+    static_cast<std::int64_t>(state.iterations() * count));
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Graph as adjacency lists in compressed sparse row form, fixed out degree
+// and uniformly random targets.
+////////////////////////////////////////////////////////////////////////////
+inline constexpr std::size_t out_degree = 8;
+
+template<class P> void BM_graph_traversal(benchmark::State &state)
+{
+  using bench::payload;
+  using link = typename P::template link<payload>;
+  auto const count = static_cast<std::size_t>(state.range(0));
+  auto payloads = bench::make_payloads(count);
+  auto const targets = bench::shuffled_indices(count);
+  std::vector<std::size_t> offsets(count + 1);
+  std::vector<link> edges;
+  edges.reserve(count * out_degree);
+  for (std::size_t u = 0; u < count; ++u) {
+    offsets[u] = edges.size();
+    for (std::size_t e = 0; e < out_degree; ++e) {
+      edges.push_back(P::make(&payloads[targets[(u * out_degree + e) % count]]));
+    }
+  }
+  offsets[count] = edges.size();
+
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (std::size_t u = 0; u < count; ++u) {
+      for (std::size_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+        sum += P::visit(
+          edges[e],
+          []() { return std::uint64_t{ 0 }; },
+          [](payload const &p) { return p.value; });
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(
+    static_cast<std::int64_t>(state.iterations() * edges.size()));
+}
+
+void node_sizes(benchmark::internal::Benchmark *b) { bench::node_counts(b); }
+
+// Eight edges per node, so the graph stops an order of magnitude earlier.
+void graph_sizes(benchmark::internal::Benchmark *b)
+{
+  bench::node_counts(b, bench::max_nodes / 10);
+}
+
+}// namespace
+
+BENCHMARK_TEMPLATE(BM_list_traversal, policy::raw_pointer)->Apply(node_sizes);
+BENCHMARK_TEMPLATE(BM_list_traversal, policy::gsl_not_null)->Apply(node_sizes);
+BENCHMARK_TEMPLATE(BM_list_traversal, policy::maybe_null)->Apply(node_sizes);
+BENCHMARK_TEMPLATE(BM_list_traversal, policy::strict_not_null)
+  ->Apply(node_sizes);
+BENCHMARK_TEMPLATE(BM_list_traversal, policy::borrower)->Apply(node_sizes);
+
+// A tree needs null children, so only the nullable pointer types take part.
+BENCHMARK_TEMPLATE(BM_tree_traversal, policy::raw_pointer)->Apply(node_sizes);
+BENCHMARK_TEMPLATE(BM_tree_traversal, policy::unique_ptr)->Apply(node_sizes);
+BENCHMARK_TEMPLATE(BM_tree_traversal, policy::maybe_null)->Apply(node_sizes);
+BENCHMARK_TEMPLATE(BM_tree_traversal, policy::borrower)->Apply(node_sizes);
+BENCHMARK_TEMPLATE(BM_tree_traversal, policy::owner)->Apply(node_sizes);
+
+BENCHMARK_TEMPLATE(BM_graph_traversal, policy::raw_pointer)
+  ->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(BM_graph_traversal, policy::gsl_not_null)
+  ->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(BM_graph_traversal, policy::maybe_null)->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(BM_graph_traversal, policy::strict_not_null)
+  ->Apply(graph_sizes);
+BENCHMARK_TEMPLATE(BM_graph_traversal, policy::borrower)->Apply(graph_sizes);
+
+// NOLINTEND
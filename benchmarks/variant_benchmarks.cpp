@@ -0,0 +1,104 @@
+// Dispatch on variant_not_null<T *>, whose pointer is its own index,
+// against std::visit on std::variant<std::nullptr_t, strict_not_null<T *>>
+// and against a test of a raw pointer.  Every element is visited once per
+// iteration, one in eight is null at pseudo-random places, up to 100M
+// elements.  The non-null elements share a small working set of payloads,
+// so that the elements themselves are the memory traffic: 8 bytes each,
+// 16 for the std::variant.
+
+#include "benchmark_support.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+// NOLINTBEGIN
+
+namespace {
+
+using bench::payload;
+
+template<typename... F> struct overloaded : F...
+{
+  using F::operator()...;
+};
+
+bool is_null_at(std::size_t i)
+{
+  return ((i * 0x9e3779b97f4a7c15ULL) >> 61U) == 0;
+}
+
+struct raw_elements
+{
+  using type = payload *;
+  static type make(payload *p) { return p; }
+  static std::uint64_t value(type e) { return e == nullptr ? 1 : e->value; }
+};
+
+struct niche_elements
+{
+  using type = mp::variant_not_null<payload *>;
+  static type make(payload *p)
+  {
+    return mp::maybe_null<payload *>(p).as_variant_not_null();
+  }
+  static std::uint64_t value(type const &e)
+  {
+    return visit(overloaded{ [](std::nullptr_t) { return std::uint64_t{ 1 }; },
+                   [](mp::strict_not_null<payload *> p) { return p->value; } },
+      e);
+  }
+};
+
+struct std_variant_elements
+{
+  using type = std::variant<std::nullptr_t, mp::strict_not_null<payload *>>;
+  static type make(payload *p)
+  {
+    return mp::maybe_null<payload *>(p).as_variant_not_null();
+  }
+  static std::uint64_t value(type const &e)
+  {
+    return std::visit(
+      overloaded{ [](std::nullptr_t) { return std::uint64_t{ 1 }; },
+        [](mp::strict_not_null<payload *> p) { return p->value; } },
+      e);
+  }
+};
+
+template<class E> void BM_variant_dispatch(benchmark::State &state)
+{
+  auto const count = static_cast<std::size_t>(state.range(0));
+  auto payloads = bench::make_payloads(bench::working_set);
+  std::vector<typename E::type> elements;
+  elements.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    elements.push_back(E::make(
+      is_null_at(i) ? nullptr : &payloads[i % bench::working_set]));
+  }
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (auto const &e : elements) { sum += E::value(e); }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["bytes_per_item"] =
+    static_cast<double>(sizeof(typename E::type));
+}
+
+void element_counts(benchmark::internal::Benchmark *b)
+{
+  b->RangeMultiplier(10)->Range(
+    1'000, std::min<std::int64_t>(100'000'000, bench::max_nodes));
+  b->Unit(benchmark::kMicrosecond);
+}
+
+}// namespace
+
+BENCHMARK_TEMPLATE(BM_variant_dispatch, raw_elements)->Apply(element_counts);
+BENCHMARK_TEMPLATE(BM_variant_dispatch, niche_elements)->Apply(element_counts);
+BENCHMARK_TEMPLATE(BM_variant_dispatch, std_variant_elements)
+  ->Apply(element_counts);
+
+// NOLINTEND
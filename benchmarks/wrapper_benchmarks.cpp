@@ -0,0 +1,354 @@
+// Micro benchmarks of the individual operations of each wrapper, measured
+// against the same operation on a raw pointer.
+
+#include "benchmark_support.hpp"
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// NOLINTBEGIN
+
+namespace {
+
+using bench::payload;
+namespace policy = bench::policy;
+
+template<class P> using link_t = typename P::template link<payload>;
+
+template<class P>
+concept has_get = requires(link_t<P> const &l) { P::get(l); };
+
+// A working set of non-null links.  For owning smart pointers every link
+// owns its own payload, otherwise the links point into `payloads`.
+template<class P> struct working_set
+{
+  std::vector<payload> payloads = bench::make_payloads(bench::working_set);
+  std::vector<link_t<P>> links;
+
+  working_set()
+  {
+    links.reserve(payloads.size());
+    for (auto &p : payloads) {
+      if constexpr (std::is_same_v<P, policy::unique_ptr>) {
+        links.push_back(P::make(new payload{ p.value }));
+      } else {
+        links.push_back(P::make(&p));
+      }
+    }
+  }
+};
+
+template<class P> void set_items(benchmark::State &state)
+{
+  state.SetItemsProcessed(
+    static_cast<std::int64_t>(state.iterations() * bench::working_set));
+}
+
+// Wrap a pointer that is already known to be valid.
+template<class P> void BM_construct(benchmark::State &state)
+{
+  auto payloads = bench::make_payloads(bench::working_set);
+  for (auto _ : state) {
+    for (auto &p : payloads) {
+      auto l = P::make(&p);
+      benchmark::DoNotOptimize(l);
+    }
+  }
+  set_items<P>(state);
+}
+
+template<class P> void BM_copy(benchmark::State &state)
+{
+  working_set<P> set;
+  for (auto _ : state) {
+    for (auto const &l : set.links) {
+      link_t<P> copy(l);
+      benchmark::DoNotOptimize(copy);
+    }
+  }
+  set_items<P>(state);
+}
+
+// Moves every link between two buffers, so moved-from objects are destroyed
+// as they would be in a container reallocation.
+template<class P> void BM_move(benchmark::State &state)
+{
+  working_set<P> set;
+  std::allocator<link_t<P>> allocator;
+  link_t<P> *from = allocator.allocate(bench::working_set);
+  link_t<P> *to = allocator.allocate(bench::working_set);
+  for (std::size_t i = 0; i < bench::working_set; ++i) {
+    std::construct_at(from + i, std::move(set.links[i]));
+  }
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < bench::working_set; ++i) {
+      std::construct_at(to + i, std::move(from[i]));
+      std::destroy_at(from + i);
+    }
+    benchmark::DoNotOptimize(to);
+    std::swap(from, to);
+  }
+  for (std::size_t i = 0; i < bench::working_set; ++i) {
+    std::destroy_at(from + i);
+  }
+  allocator.deallocate(from, bench::working_set);
+  allocator.deallocate(to, bench::working_set);
+  set_items<P>(state);
+}
+
+template<class P>
+  requires has_get<P>
+void BM_get(benchmark::State &state)
+{
+  working_set<P> set;
+  for (auto _ : state) {
+    for (auto const &l : set.links) {
+      payload *raw = P::get(l);
+      benchmark::DoNotOptimize(raw);
+    }
+  }
+  set_items<P>(state);
+}
+
+template<class P>
+  requires has_get<P>
+void BM_arrow(benchmark::State &state)
+{
+  working_set<P> set;
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (auto const &l : set.links) { sum += l->value; }
+    benchmark::DoNotOptimize(sum);
+  }
+  set_items<P>(state);
+}
+
+template<class P> void BM_visit(benchmark::State &state)
+{
+  working_set<P> set;
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (auto const &l : set.links) {
+      sum += P::visit(
+        l,
+        []() { return std::uint64_t{ 0 }; },
+        [](payload const &p) { return p.value; });
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  set_items<P>(state);
+}
+
+// maybe_null::as_optional_not_null against the equivalent null test on a
+// raw pointer.
+template<class P> void BM_as_optional_not_null(benchmark::State &state)
+{
+  working_set<P> set;
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (auto const &l : set.links) {
+      if constexpr (std::is_same_v<P, policy::maybe_null>) {
+        auto opt = l.as_optional_not_null();
+        if (opt.has_value()) { sum += (*opt)->value; }
+      } else {
+        if (l != nullptr) { sum += l->value; }
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  set_items<P>(state);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Conversions
+//
+// A raw pointer that may be null, tested once and then used as
+// strict_not_null:
+//
+//   raw_pointer       the test alone
+//   maybe_null        maybe_null::visit
+//   assume_not_null   the test, then the unchecked constructor
+//   checked_not_null  the test, then the checking constructor, which tests
+//                     the pointer a second time
+//
+//   convert(p, n, v)  calls n() if p is null, v(strict_not_null) otherwise
+////////////////////////////////////////////////////////////////////////////
+namespace conversion {
+
+  struct raw_pointer
+  {
+    template<class N, class V>
+    static decltype(auto) convert(payload *p, N &&on_null, V &&on_value)
+    {
+      if (p == nullptr) { return on_null(); }
+      return on_value(p);
+    }
+  };
+
+  struct maybe_null
+  {
+    template<class N, class V>
+    static decltype(auto) convert(payload *p, N &&on_null, V &&on_value)
+    {
+      return mp::maybe_null<payload *>(p).visit(
+        [&](std::nullptr_t) { return on_null(); },
+        [&](mp::strict_not_null<payload *> q) { return on_value(q); });
+    }
+  };
+
+  struct assume_not_null
+  {
+    template<class N, class V>
+    static decltype(auto) convert(payload *p, N &&on_null, V &&on_value)
+    {
+      if (p == nullptr) { return on_null(); }
+      return on_value(mp::strict_not_null<payload *>(mp::assume_not_null, p));
+    }
+  };
+
+  struct checked_not_null
+  {
+    template<class N, class V>
+    static decltype(auto) convert(payload *p, N &&on_null, V &&on_value)
+    {
+      if (p == nullptr) { return on_null(); }
+      return on_value(mp::strict_not_null<payload *>(p));
+    }
+  };
+
+}// namespace conversion
+
+// Every eighth pointer is null.  The handler tests the pointer again, as
+// defensive code would, which folds away when the optimizer knows that a
+// strict_not_null is not null.
+template<class C> void BM_convert(benchmark::State &state)
+{
+  auto payloads = bench::make_payloads(bench::working_set);
+  std::vector<payload *> pointers;
+  for (std::size_t i = 0; i < payloads.size(); ++i) {
+    pointers.push_back(i % 8 == 0 ? nullptr : &payloads[i]);
+  }
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (auto *const p : pointers) {
+      sum += C::convert(
+        p,
+        []() { return std::uint64_t{ 0 }; },
+        [](auto q) {
+          payload const *raw = nullptr;
+          if constexpr (std::is_pointer_v<decltype(q)>) {
+            raw = q;
+          } else {
+            raw = q.get();
+          }
+          return raw == nullptr ? std::uint64_t{ 1 } : raw->value;
+        });
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(
+    static_cast<std::int64_t>(state.iterations() * pointers.size()));
+}
+
+template<class P> void BM_equal(benchmark::State &state)
+{
+  working_set<P> set;
+  for (auto _ : state) {
+    std::size_t count = 0;
+    for (std::size_t i = 1; i < set.links.size(); ++i) {
+      if (set.links[i - 1] == set.links[i]) { ++count; }
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  set_items<P>(state);
+}
+
+template<class P> void BM_less(benchmark::State &state)
+{
+  working_set<P> set;
+  for (auto _ : state) {
+    std::size_t count = 0;
+    for (std::size_t i = 1; i < set.links.size(); ++i) {
+      if (set.links[i - 1] < set.links[i]) { ++count; }
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  set_items<P>(state);
+}
+
+}// namespace
+
+// unique_ptr is not constructed here: it would take ownership of the
+// payloads.
+BENCHMARK_TEMPLATE(BM_construct, policy::raw_pointer);
+BENCHMARK_TEMPLATE(BM_construct, policy::gsl_not_null);
+BENCHMARK_TEMPLATE(BM_construct, policy::maybe_null);
+BENCHMARK_TEMPLATE(BM_construct, policy::strict_not_null);
+BENCHMARK_TEMPLATE(BM_construct, policy::borrower);
+BENCHMARK_TEMPLATE(BM_construct, policy::owner);
+
+BENCHMARK_TEMPLATE(BM_copy, policy::raw_pointer);
+BENCHMARK_TEMPLATE(BM_copy, policy::gsl_not_null);
+BENCHMARK_TEMPLATE(BM_copy, policy::maybe_null);
+BENCHMARK_TEMPLATE(BM_copy, policy::strict_not_null);
+BENCHMARK_TEMPLATE(BM_copy, policy::borrower);
+BENCHMARK_TEMPLATE(BM_copy, policy::owner);
+
+BENCHMARK_TEMPLATE(BM_move, policy::raw_pointer);
+BENCHMARK_TEMPLATE(BM_move, policy::unique_ptr);
+BENCHMARK_TEMPLATE(BM_move, policy::gsl_not_null);
+BENCHMARK_TEMPLATE(BM_move, policy::maybe_null);
+BENCHMARK_TEMPLATE(BM_move, policy::strict_not_null);
+BENCHMARK_TEMPLATE(BM_move, policy::borrower);
+BENCHMARK_TEMPLATE(BM_move, policy::owner);
+
+// maybe_null::get() is deprecated, its access path is visit.
+BENCHMARK_TEMPLATE(BM_get, policy::raw_pointer);
+BENCHMARK_TEMPLATE(BM_get, policy::unique_ptr);
+BENCHMARK_TEMPLATE(BM_get, policy::gsl_not_null);
+BENCHMARK_TEMPLATE(BM_get, policy::strict_not_null);
+BENCHMARK_TEMPLATE(BM_get, policy::borrower);
+BENCHMARK_TEMPLATE(BM_get, policy::owner);
+
+BENCHMARK_TEMPLATE(BM_arrow, policy::raw_pointer);
+BENCHMARK_TEMPLATE(BM_arrow, policy::unique_ptr);
+BENCHMARK_TEMPLATE(BM_arrow, policy::gsl_not_null);
+BENCHMARK_TEMPLATE(BM_arrow, policy::strict_not_null);
+BENCHMARK_TEMPLATE(BM_arrow, policy::borrower);
+BENCHMARK_TEMPLATE(BM_arrow, policy::owner);
+
+BENCHMARK_TEMPLATE(BM_visit, policy::raw_pointer);
+BENCHMARK_TEMPLATE(BM_visit, policy::unique_ptr);
+BENCHMARK_TEMPLATE(BM_visit, policy::gsl_not_null);
+BENCHMARK_TEMPLATE(BM_visit, policy::maybe_null);
+BENCHMARK_TEMPLATE(BM_visit, policy::strict_not_null);
+BENCHMARK_TEMPLATE(BM_visit, policy::borrower);
+BENCHMARK_TEMPLATE(BM_visit, policy::owner);
+
+BENCHMARK_TEMPLATE(BM_as_optional_not_null, policy::raw_pointer);
+BENCHMARK_TEMPLATE(BM_as_optional_not_null, policy::maybe_null);
+
+BENCHMARK_TEMPLATE(BM_convert, conversion::raw_pointer);
+BENCHMARK_TEMPLATE(BM_convert, conversion::maybe_null);
+BENCHMARK_TEMPLATE(BM_convert, conversion::assume_not_null);
+BENCHMARK_TEMPLATE(BM_convert, conversion::checked_not_null);
+
+BENCHMARK_TEMPLATE(BM_equal, policy::raw_pointer);
+BENCHMARK_TEMPLATE(BM_equal, policy::unique_ptr);
+BENCHMARK_TEMPLATE(BM_equal, policy::gsl_not_null);
+BENCHMARK_TEMPLATE(BM_equal, policy::maybe_null);
+BENCHMARK_TEMPLATE(BM_equal, policy::strict_not_null);
+BENCHMARK_TEMPLATE(BM_equal, policy::borrower);
+BENCHMARK_TEMPLATE(BM_equal, policy::owner);
+
+BENCHMARK_TEMPLATE(BM_less, policy::raw_pointer);
+BENCHMARK_TEMPLATE(BM_less, policy::unique_ptr);
+BENCHMARK_TEMPLATE(BM_less, policy::gsl_not_null);
+BENCHMARK_TEMPLATE(BM_less, policy::maybe_null);
+BENCHMARK_TEMPLATE(BM_less, policy::strict_not_null);
+BENCHMARK_TEMPLATE(BM_less, policy::borrower);
+BENCHMARK_TEMPLATE(BM_less, policy::owner);
+
+// NOLINTEND
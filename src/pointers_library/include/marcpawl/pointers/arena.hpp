@@ -0,0 +1,185 @@
+#pragma once
+
+#include "marcpawl/pointers/core.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace marcpawl {
+namespace pointers {
+  MP_BEGIN_EXPORT
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  // arena
+  //
+  // Monotonic allocator for objects that all die together, e.g. at the end
+  // of a request.  Allocation bumps a pointer in the current block, nothing
+  // is freed until release() or the destruction of the arena, which run the
+  // destructors of the objects that have one, most recent first, and free
+  // the blocks at once.
+  //
+  //   arena request_arena;
+  //   owner<Node *> node = request_arena.make<Node>(42);
+  //   borrower<Node *> view = node.as_borrower();
+  //   ...
+  //   request_arena.release();// node and view are dangling from here
+  //
+  // The owner returned by make() is owned through the arena: it must not be
+  // deleted, and it and every borrower made from it stay valid until the
+  // arena is released.
+  //
+  // release() keeps the largest block for the next request, so an arena
+  // reused request after request stops allocating once a block holds a
+  // whole request.
+  ////////////////////////////////////////////////////////////////////////////
+  class arena
+  {
+  public:
+    static constexpr std::size_t default_block_size = 4096;
+
+    explicit arena(std::size_t block_size = default_block_size)
+      : next_block_size_(std::max(block_size, sizeof(block)))
+    {}
+
+    arena(arena const &) = delete;
+    arena &operator=(arena const &) = delete;
+
+    ~arena()
+    {
+      release();
+      free_blocks(blocks_);
+    }
+
+    // Constructs a T in the arena.
+    template<typename T, typename... Args>
+    [[nodiscard]] owner<T *> make(Args &&...args)
+    {
+      // With MP_BORROW_CHECKS every object is recorded, so that release()
+      // ends its borrows.
+      constexpr bool recorded =
+        !std::is_trivially_destructible_v<T> || details::borrow_checks;
+      destructor *record = nullptr;
+      if constexpr (recorded) {
+        record = static_cast<destructor *>(
+          allocate(sizeof(destructor), alignof(destructor)));
+      }
+      T *const object = ::new (allocate(sizeof(T), alignof(T)))
+        T(std::forward<Args>(args)...);
+      if constexpr (recorded) {
+        *record = destructor{ &destroy<T>, object, destructors_ };
+        destructors_ = record;
+      }
+      return owner<T *>(object);
+    }
+
+    // Uninitialised storage, bytes is not zero and alignment is a power of
+    // two.
+    [[nodiscard]] void *allocate(std::size_t bytes,
+      std::size_t alignment = alignof(std::max_align_t))
+    {
+      auto const start = align_up(current_, alignment);
+      if (start <= end_ && bytes <= end_ - start) {
+        current_ = start + bytes;
+        return reinterpret_cast<void *>(start);
+      }
+      return allocate_from_new_block(bytes, alignment);
+    }
+
+    // Destroys every object, most recent first, and frees all blocks but
+    // the largest, which is reused.
+    void release() noexcept
+    {
+      for (auto const *d = destructors_; d != nullptr; d = d->next) {
+        d->destroy(d->object);
+      }
+      destructors_ = nullptr;
+      if (blocks_ == nullptr) { return; }
+      // Blocks grow, the most recent one is the largest.
+      free_blocks(blocks_->next);
+      blocks_->next = nullptr;
+      current_ = data(blocks_);
+      end_ = reinterpret_cast<std::uintptr_t>(blocks_) + blocks_->size;
+    }
+
+    // Bytes of the blocks held, in use or not.
+    [[nodiscard]] std::size_t capacity() const noexcept
+    {
+      std::size_t total = 0;
+      for (auto const *b = blocks_; b != nullptr; b = b->next) {
+        total += b->size;
+      }
+      return total;
+    }
+
+  private:
+    struct block
+    {
+      block *next;
+      std::size_t size;
+    };
+
+    struct destructor
+    {
+      void (*destroy)(void *) noexcept;
+      void *object;
+      destructor const *next;
+    };
+
+    template<typename T> static void destroy(void *object) noexcept
+    {
+      end_borrows(object);
+      std::destroy_at(static_cast<T *>(object));
+    }
+
+    static std::uintptr_t align_up(std::uintptr_t address,
+      std::size_t alignment) noexcept
+    {
+      return (address + alignment - 1) & ~(std::uintptr_t{ alignment } - 1);
+    }
+
+    static std::uintptr_t data(block *b) noexcept
+    {
+      return reinterpret_cast<std::uintptr_t>(b) + sizeof(block);
+    }
+
+    static void free_blocks(block *b) noexcept
+    {
+      while (b != nullptr) {
+        block *const next = b->next;
+        ::operator delete(b);
+        b = next;
+      }
+    }
+
+    void *allocate_from_new_block(std::size_t bytes, std::size_t alignment)
+    {
+      // Blocks double in size, a request larger than the next block gets a
+      // block of its own size.
+      std::size_t const needed = sizeof(block) + bytes + alignment - 1;
+      std::size_t const size = std::max(next_block_size_, needed);
+      auto *const b = static_cast<block *>(::operator new(size));
+      *b = block{ blocks_, size };
+      blocks_ = b;
+      next_block_size_ = std::bit_ceil(size) * 2;
+      current_ = data(b);
+      end_ = reinterpret_cast<std::uintptr_t>(b) + size;
+      return allocate(bytes, alignment);
+    }
+
+    block *blocks_ = nullptr;
+    destructor const *destructors_ = nullptr;
+    std::uintptr_t current_ = 0;
+    std::uintptr_t end_ = 0;
+    std::size_t next_block_size_;
+  };
+
+  MP_END_EXPORT
+}// namespace pointers
+}// namespace marcpawl
@@ -0,0 +1,282 @@
+#pragma once
+
+#include "marcpawl/pointers/core.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace marcpawl {
+namespace pointers {
+  MP_BEGIN_EXPORT
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  // atomic_maybe_null, atomic_strict_not_null
+  //
+  // std::atomic<T> for a raw pointer T, whose operations take and return
+  // maybe_null<T> or strict_not_null<T>, so that a pointer shared between
+  // threads keeps its null-safety type:
+  //
+  //   atomic_strict_not_null<Config *> current{ strict_not_null(&initial) };
+  //   current.store(strict_not_null(&updated));// writer
+  //   strict_not_null<Config *> config = current.load();// readers
+  //
+  // Only strict_not_null values are ever stored in an
+  // atomic_strict_not_null, so that a load needs no test: there is no
+  // default constructor, and compare_exchange only replaces the expected
+  // value with one that was stored.
+  //
+  // Both are lock free, with the size of the pointer.  Alignment is that of
+  // std::atomic<T>; padded_atomic_maybe_null and
+  // padded_atomic_strict_not_null are aligned to a cache line, so that two
+  // of them are never on the same line and writers of one do not slow down
+  // readers of the other.
+  ////////////////////////////////////////////////////////////////////////////
+
+  // Assumed size of a cache line, the alignment of the padded atomics.
+  inline constexpr std::size_t cache_line_size = 64;
+
+  MP_END_EXPORT
+
+  namespace details {
+    template<RawPointer T, std::size_t Alignment> class atomic_pointer
+    {
+      static_assert(std::atomic<T>::is_always_lock_free);
+      static_assert(Alignment >= alignof(std::atomic<T>));
+
+    public:
+      static constexpr bool is_always_lock_free = true;
+
+      atomic_pointer(atomic_pointer const &) = delete;
+      atomic_pointer &operator=(atomic_pointer const &) = delete;
+
+      [[nodiscard]] bool is_lock_free() const noexcept
+      {
+        return ptr_.is_lock_free();
+      }
+
+      void notify_one() noexcept { ptr_.notify_one(); }
+      void notify_all() noexcept { ptr_.notify_all(); }
+
+    protected:
+      constexpr explicit atomic_pointer(T ptr) noexcept : ptr_(ptr) {}
+      ~atomic_pointer() = default;
+
+      alignas(Alignment) std::atomic<T> ptr_;
+    };
+  }// namespace details
+
+  MP_BEGIN_EXPORT
+
+  template<details::RawPointer T,
+    std::size_t Alignment = alignof(std::atomic<T>)>
+  class atomic_maybe_null : public details::atomic_pointer<T, Alignment>
+  {
+    using base = details::atomic_pointer<T, Alignment>;
+
+  public:
+    using value_type = maybe_null<T>;
+
+    constexpr atomic_maybe_null() noexcept : base(nullptr) {}
+    constexpr explicit atomic_maybe_null(std::nullptr_t) noexcept
+      : base(nullptr)
+    {}
+    constexpr explicit atomic_maybe_null(maybe_null<T> ptr) noexcept
+      : base(ptr.ptr_)
+    {}
+
+    [[nodiscard]] maybe_null<T> load(
+      std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+      return maybe_null<T>(this->ptr_.load(order));
+    }
+
+    void store(maybe_null<T> desired,
+      std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+      this->ptr_.store(desired.ptr_, order);
+    }
+
+    maybe_null<T> exchange(maybe_null<T> desired,
+      std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+      return maybe_null<T>(this->ptr_.exchange(desired.ptr_, order));
+    }
+
+    bool compare_exchange_weak(maybe_null<T> &expected,
+      maybe_null<T> desired,
+      std::memory_order success,
+      std::memory_order failure) noexcept
+    {
+      return this->ptr_.compare_exchange_weak(
+        expected.ptr_, desired.ptr_, success, failure);
+    }
+
+    bool compare_exchange_weak(maybe_null<T> &expected,
+      maybe_null<T> desired,
+      std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+      return this->ptr_.compare_exchange_weak(
+        expected.ptr_, desired.ptr_, order);
+    }
+
+    bool compare_exchange_strong(maybe_null<T> &expected,
+      maybe_null<T> desired,
+      std::memory_order success,
+      std::memory_order failure) noexcept
+    {
+      return this->ptr_.compare_exchange_strong(
+        expected.ptr_, desired.ptr_, success, failure);
+    }
+
+    bool compare_exchange_strong(maybe_null<T> &expected,
+      maybe_null<T> desired,
+      std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+      return this->ptr_.compare_exchange_strong(
+        expected.ptr_, desired.ptr_, order);
+    }
+
+    // Blocks while the value is old.
+    void wait(maybe_null<T> old,
+      std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+      this->ptr_.wait(old.ptr_, order);
+    }
+  };
+
+
+  template<details::RawPointer T,
+    std::size_t Alignment = alignof(std::atomic<T>)>
+  class atomic_strict_not_null : public details::atomic_pointer<T, Alignment>
+  {
+    using base = details::atomic_pointer<T, Alignment>;
+
+  public:
+    using value_type = strict_not_null<T>;
+
+    atomic_strict_not_null() = delete;
+    constexpr explicit atomic_strict_not_null(strict_not_null<T> ptr) noexcept
+      : base(ptr.ptr_)
+    {}
+
+    [[nodiscard]] strict_not_null<T> load(
+      std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+      return strict_not_null<T>(assume_not_null, this->ptr_.load(order));
+    }
+
+    void store(strict_not_null<T> desired,
+      std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+      this->ptr_.store(desired.ptr_, order);
+    }
+
+    strict_not_null<T> exchange(strict_not_null<T> desired,
+      std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+      return strict_not_null<T>(
+        assume_not_null, this->ptr_.exchange(desired.ptr_, order));
+    }
+
+    bool compare_exchange_weak(strict_not_null<T> &expected,
+      strict_not_null<T> desired,
+      std::memory_order success,
+      std::memory_order failure) noexcept
+    {
+      return this->ptr_.compare_exchange_weak(
+        expected.ptr_, desired.ptr_, success, failure);
+    }
+
+    bool compare_exchange_weak(strict_not_null<T> &expected,
+      strict_not_null<T> desired,
+      std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+      return this->ptr_.compare_exchange_weak(
+        expected.ptr_, desired.ptr_, order);
+    }
+
+    bool compare_exchange_strong(strict_not_null<T> &expected,
+      strict_not_null<T> desired,
+      std::memory_order success,
+      std::memory_order failure) noexcept
+    {
+      return this->ptr_.compare_exchange_strong(
+        expected.ptr_, desired.ptr_, success, failure);
+    }
+
+    bool compare_exchange_strong(strict_not_null<T> &expected,
+      strict_not_null<T> desired,
+      std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+      return this->ptr_.compare_exchange_strong(
+        expected.ptr_, desired.ptr_, order);
+    }
+
+    // Blocks while the value is old.
+    void wait(strict_not_null<T> old,
+      std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+      this->ptr_.wait(old.ptr_, order);
+    }
+  };
+
+  MP_END_EXPORT
+
+  namespace details {
+    // The raw pointer held by any atomic source of a borrower, for the
+    // reclamation domains.
+    template<RawPointer T>
+    T load_pointer(
+      std::atomic<T> const &source, std::memory_order order) noexcept
+    {
+      return source.load(order);
+    }
+
+    template<RawPointer T, std::size_t A>
+    T load_pointer(atomic_maybe_null<T, A> const &source,
+      std::memory_order order) noexcept
+    {
+      return source.load(order).ptr_;
+    }
+
+    template<RawPointer T, std::size_t A>
+    T load_pointer(atomic_strict_not_null<T, A> const &source,
+      std::memory_order order) noexcept
+    {
+      return source.load(order).ptr_;
+    }
+
+    template<RawPointer T>
+    T exchange_pointer(std::atomic<T> &source, T desired) noexcept
+    {
+      return source.exchange(desired);
+    }
+
+    template<RawPointer T, std::size_t A>
+    T exchange_pointer(atomic_maybe_null<T, A> &source, T desired) noexcept
+    {
+      return source.exchange(maybe_null<T>(desired)).ptr_;
+    }
+
+    // Checks that desired is not null.
+    template<RawPointer T, std::size_t A>
+    T exchange_pointer(atomic_strict_not_null<T, A> &source, T desired)
+    {
+      return source.exchange(strict_not_null<T>(desired)).ptr_;
+    }
+  }// namespace details
+
+  MP_BEGIN_EXPORT
+
+  template<details::RawPointer T>
+  using padded_atomic_maybe_null = atomic_maybe_null<T, cache_line_size>;
+
+  template<details::RawPointer T>
+  using padded_atomic_strict_not_null =
+    atomic_strict_not_null<T, cache_line_size>;
+
+  MP_END_EXPORT
+}// namespace pointers
+}// namespace marcpawl
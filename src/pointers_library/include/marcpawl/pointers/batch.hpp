@@ -0,0 +1,189 @@
+#pragma once
+
+#include "marcpawl/pointers/core.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <variant>
+
+// MP_NO_SIMD keeps to the scalar loop.
+#if !defined(MP_NO_SIMD)
+#if defined(__AVX512F__) || defined(__AVX2__) || defined(__SSE2__) \
+  || defined(_M_X64)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+#endif
+
+namespace marcpawl {
+namespace pointers {
+  MP_BEGIN_EXPORT
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  // Batch validation
+  //
+  // Checks a whole array of raw pointers at once, e.g. one handed over by a
+  // C API, and views it as strict_not_null pointers without copying:
+  //
+  //   std::span<Node *> nodes = ...;
+  //   auto checked = as_not_null_span(nodes);
+  //   if (auto const *null = std::get_if<null_at>(&checked)) {
+  //     return error(null->index);
+  //   }
+  //   for (strict_not_null<Node *> node : std::get<1>(checked)) { ... }
+  //
+  // The wrappers have the layout of the pointer, so the array becomes an
+  // array of wrappers in place: from then on it is read through the
+  // returned span, not as raw pointers.
+  //
+  // The pointers are compared to zero a vector at a time, with AVX-512, AVX2
+  // or SSE2 on x86-64 and NEON on AArch64, as enabled by the compiler flags.
+  ////////////////////////////////////////////////////////////////////////////
+
+  // The first null pointer of a batch.
+  struct null_at
+  {
+    std::size_t index;
+
+    friend bool operator==(null_at, null_at) = default;
+  };
+
+  MP_END_EXPORT
+
+  namespace details {
+    // A non-null wrapper that can take the place of a P in memory.
+    template<typename W, typename P>
+    concept NotNullView =
+      std::is_pointer_v<P>
+      && (std::same_as<W, strict_not_null<P>>
+          || std::same_as<W, borrower<strict_not_null<P>>>)
+      && sizeof(W) == sizeof(P) && alignof(W) == alignof(P)
+      && std::is_trivially_copyable_v<W>;
+
+    // Index of the first null of count pointers, count when there is none.
+    // A vector holding a null stops the vector loop, and the scalar loop
+    // finds which one it is.
+    template<typename T>
+    std::size_t find_null(T *const *pointers, std::size_t count) noexcept
+    {
+      std::size_t i = 0;
+#if !defined(MP_NO_SIMD)
+      if constexpr (sizeof(T *) == sizeof(std::uint64_t)) {
+#if defined(__AVX512F__)
+        __m512i const zero = _mm512_setzero_si512();
+        for (; i + 16 <= count; i += 16) {
+          __mmask8 const a =
+            _mm512_cmpeq_epi64_mask(_mm512_loadu_si512(pointers + i), zero);
+          __mmask8 const b = _mm512_cmpeq_epi64_mask(
+            _mm512_loadu_si512(pointers + i + 8), zero);
+          if ((a | b) != 0) { break; }
+        }
+#elif defined(__AVX2__)
+        __m256i const zero = _mm256_setzero_si256();
+        auto const load = [pointers](std::size_t at) {
+          return _mm256_loadu_si256(
+            reinterpret_cast<__m256i const *>(pointers + at));
+        };
+        for (; i + 16 <= count; i += 16) {
+          __m256i const any = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi64(load(i), zero),
+              _mm256_cmpeq_epi64(load(i + 4), zero)),
+            _mm256_or_si256(_mm256_cmpeq_epi64(load(i + 8), zero),
+              _mm256_cmpeq_epi64(load(i + 12), zero)));
+          if (_mm256_testz_si256(any, any) == 0) { break; }
+        }
+#elif defined(__SSE2__) || defined(_M_X64)
+        // SSE2 has no 64 bit compare: both halves must be zero.
+        __m128i const zero = _mm_setzero_si128();
+        auto const is_null = [pointers, zero](std::size_t at) {
+          __m128i const halves = _mm_cmpeq_epi32(
+            _mm_loadu_si128(reinterpret_cast<__m128i const *>(pointers + at)),
+            zero);
+          return _mm_and_si128(
+            halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+        };
+        for (; i + 8 <= count; i += 8) {
+          __m128i const any =
+            _mm_or_si128(_mm_or_si128(is_null(i), is_null(i + 2)),
+              _mm_or_si128(is_null(i + 4), is_null(i + 6)));
+          if (_mm_movemask_epi8(any) != 0) { break; }
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        auto const is_null = [pointers](std::size_t at) {
+          return vceqzq_u64(
+            vld1q_u64(reinterpret_cast<std::uint64_t const *>(pointers + at)));
+        };
+        for (; i + 8 <= count; i += 8) {
+          uint64x2_t const any =
+            vorrq_u64(vorrq_u64(is_null(i), is_null(i + 2)),
+              vorrq_u64(is_null(i + 4), is_null(i + 6)));
+          if (vmaxvq_u32(vreinterpretq_u32_u64(any)) != 0) { break; }
+        }
+#endif
+      }
+#endif// !defined(MP_NO_SIMD)
+      for (; i < count; ++i) {
+        if (pointers[i] == nullptr) { return i; }
+      }
+      return count;
+    }
+
+    // Ends the lifetime of the count objects at memory, and starts that of
+    // count W objects with the same bytes, as std::start_lifetime_as_array.
+    // memmove implicitly creates objects, and a move onto itself is folded
+    // away by the optimizer.
+    template<typename W>
+    W *start_lifetime_as_array(void *memory, std::size_t count) noexcept
+    {
+#if defined(__cpp_lib_start_lifetime_as)
+      return std::start_lifetime_as_array<W>(memory, count);
+#else
+      return std::launder(
+        static_cast<W *>(std::memmove(memory, memory, count * sizeof(W))));
+#endif
+    }
+  }// namespace details
+
+  MP_BEGIN_EXPORT
+
+  // Index of the first null pointer, pointers.size() when there is none.
+  template<typename P, std::size_t Extent>
+    requires std::is_pointer_v<std::remove_const_t<P>>
+  [[nodiscard]] std::size_t find_null(std::span<P, Extent> pointers) noexcept
+  {
+    return details::find_null(pointers.data(), pointers.size());
+  }
+
+  // pointers viewed as W, strict_not_null<T *> by default or
+  // borrower<strict_not_null<T *>>, or the first null pointer.
+  template<typename W = void, typename T, std::size_t Extent>
+    requires details::NotNullView<
+      std::conditional_t<std::is_void_v<W>, strict_not_null<T *>, W>,
+      T *>
+  [[nodiscard]] auto as_not_null_span(std::span<T *, Extent> pointers) noexcept
+    -> std::variant<null_at,
+      std::span<std::conditional_t<std::is_void_v<W>, strict_not_null<T *>, W>,
+        Extent>>
+  {
+    using view = std::conditional_t<std::is_void_v<W>, strict_not_null<T *>, W>;
+    // The data() of an empty span may be null, which memmove must not get.
+    if constexpr (Extent == 0 || Extent == std::dynamic_extent) {
+      if (pointers.empty()) { return std::span<view, Extent>(); }
+    }
+    std::size_t const index = find_null(pointers);
+    if (index != pointers.size()) { return null_at{ index }; }
+    return std::span<view, Extent>(
+      details::start_lifetime_as_array<view>(pointers.data(), pointers.size()),
+      pointers.size());
+  }
+
+  MP_END_EXPORT
+}// namespace pointers
+}// namespace marcpawl
@@ -0,0 +1,412 @@
+#pragma once
+
+#include "marcpawl/pointers/core.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <source_location>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#if defined(MP_CALL_SITE_PROBES) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define MP_CALL_SITE_PROBE(event, location)     \
+  DTRACE_PROBE4(marcpawl_pointers,              \
+    call_site,                                  \
+    static_cast<unsigned>(event),               \
+    (location).file_name(),                     \
+    static_cast<unsigned>((location).line()),   \
+    (location).function_name())
+#endif
+#endif
+#if !defined(MP_CALL_SITE_PROBE)
+#define MP_CALL_SITE_PROBE(event, location) ((void)0)
+#endif
+
+namespace marcpawl {
+namespace pointers {
+  MP_BEGIN_EXPORT
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  // Call site counters
+  //
+  // With MP_CALL_SITE_COUNTERS defined, every call of maybe_null#visit,
+  // maybe_null#as_optional_not_null, maybe_null#as_variant_not_null and
+  // every null check, e.g. of the strict_not_null constructor, is counted
+  // against the source location of its caller:
+  //
+  //   calls          times the site was reached
+  //   null_branches  times visit or as_optional_not_null found null
+  //   violations     times a null check failed
+  //
+  // The null_branches / calls ratio of a site tells whether its null branch
+  // is the cold one, for likelihood hints or profile guided optimization:
+  //
+  //   write_call_sites_csv(stdout, call_site_snapshot());
+  //
+  // Each thread counts in a table of its own, with plain stores, so that
+  // counting takes no lock and no read-modify-write.  call_site_snapshot()
+  // adds the tables up, those of the threads that exited included, and
+  // merges the sites of the same file, line and column.  A thread table
+  // holds call_site_capacity sites, the calls of further sites are only
+  // counted by call_sites_dropped().
+  //
+  // With MP_CALL_SITE_PROBES defined, and <sys/sdt.h> available, each event
+  // also fires the USDT probe marcpawl_pointers:call_site(event, file,
+  // line, function), for perf and bpftrace; event is 0 for a call, 1 for a
+  // null branch and 2 for a violation.
+  //
+  // Without either macro nothing is recorded, the source locations are
+  // dropped once inlined and the snapshot is empty.
+  ////////////////////////////////////////////////////////////////////////////
+  struct call_site_counts
+  {
+    char const *file = "";
+    char const *function = "";
+    std::uint_least32_t line = 0;
+    std::uint_least32_t column = 0;
+    std::uint64_t calls = 0;
+    std::uint64_t null_branches = 0;
+    std::uint64_t violations = 0;
+
+    [[nodiscard]] double null_ratio() const noexcept
+    {
+      return calls == 0 ? 0.0
+                        : static_cast<double>(null_branches)
+                            / static_cast<double>(calls);
+    }
+  };
+
+  MP_END_EXPORT
+
+  namespace details {
+    inline constexpr std::size_t call_site_capacity = 1024;
+
+    class call_site_table
+    {
+    public:
+      call_site_table() { registry().attach(this); }
+
+      call_site_table(call_site_table const &) = delete;
+      call_site_table &operator=(call_site_table const &) = delete;
+
+      ~call_site_table() { registry().detach(this); }
+
+      void count(call_site_event event,
+        std::source_location const &location) noexcept
+      {
+        slot *const s = find(location);
+        if (s == nullptr) {
+          bump(dropped_);
+          return;
+        }
+        bump(s->counts[static_cast<std::size_t>(event)]);
+      }
+
+      static call_site_table &local()
+      {
+        thread_local call_site_table table;
+        return table;
+      }
+
+      using key = std::tuple<std::string_view, std::uint_least32_t,
+        std::uint_least32_t>;
+
+      // Adds the tables of every thread, live or exited, to sites.
+      static std::uint64_t collect(std::map<key, call_site_counts> &sites)
+      {
+        return registry().collect(sites);
+      }
+
+      static void reset() { registry().reset(); }
+
+    private:
+      struct slot
+      {
+        // Written by the owning thread before used is set.
+        std::source_location location;
+        std::atomic<bool> used{ false };
+        std::atomic<std::uint64_t> counts[3] = {};
+      };
+
+      // Only the owning thread writes, so a load and a store are enough.
+      static void bump(std::atomic<std::uint64_t> &counter) noexcept
+      {
+        counter.store(counter.load(std::memory_order_relaxed) + 1,
+          std::memory_order_relaxed);
+      }
+
+      slot *find(std::source_location const &location) noexcept
+      {
+        // A loop counts the same site over and over.
+        if (last_ != nullptr && same(last_->location, location)) {
+          return last_;
+        }
+        slot *const s = probe(location);
+        if (s != nullptr) { last_ = s; }
+        return s;
+      }
+
+      static bool same(std::source_location const &lhs,
+        std::source_location const &rhs) noexcept
+      {
+        return lhs.line() == rhs.line() && lhs.column() == rhs.column()
+               && lhs.file_name() == rhs.file_name();
+      }
+
+      slot *probe(std::source_location const &location) noexcept
+      {
+        auto const file =
+          reinterpret_cast<std::uintptr_t>(location.file_name());
+        std::uint64_t const hash =
+          (file ^ (std::uint64_t{ location.line() } << 16U)
+            ^ location.column())
+          * 0x9e3779b97f4a7c15ULL;
+        // The top 10 bits, one of the call_site_capacity slots.
+        std::size_t const index = hash >> 54U;
+        for (std::size_t i = 0; i < call_site_capacity; ++i) {
+          slot &s = slots_[(index + i) & (call_site_capacity - 1)];
+          if (!s.used.load(std::memory_order_relaxed)) {
+            s.location = location;
+            s.used.store(true, std::memory_order_release);
+            return &s;
+          }
+          if (same(s.location, location)) { return &s; }
+        }
+        return nullptr;
+      }
+
+      void add_to(std::map<key, call_site_counts> &sites) const
+      {
+        for (slot const &s : slots_) {
+          if (!s.used.load(std::memory_order_acquire)) { continue; }
+          call_site_counts c;
+          c.file = s.location.file_name();
+          c.function = s.location.function_name();
+          c.line = s.location.line();
+          c.column = s.location.column();
+          c.calls = s.counts[0].load(std::memory_order_relaxed);
+          c.null_branches = s.counts[1].load(std::memory_order_relaxed);
+          c.violations = s.counts[2].load(std::memory_order_relaxed);
+          if (c.calls == 0 && c.null_branches == 0 && c.violations == 0) {
+            continue;
+          }
+          add(sites, key{ c.file, c.line, c.column }, c);
+        }
+      }
+
+      static void add(std::map<key, call_site_counts> &sites,
+        key const &k,
+        call_site_counts const &counts)
+      {
+        auto const [it, inserted] = sites.try_emplace(k, counts);
+        if (!inserted) {
+          it->second.calls += counts.calls;
+          it->second.null_branches += counts.null_branches;
+          it->second.violations += counts.violations;
+        }
+      }
+
+      void clear() noexcept
+      {
+        for (slot &s : slots_) {
+          for (auto &c : s.counts) { c.store(0, std::memory_order_relaxed); }
+        }
+        dropped_.store(0, std::memory_order_relaxed);
+      }
+
+      class table_registry
+      {
+      public:
+        void attach(call_site_table *table)
+        {
+          std::lock_guard<std::mutex> const lock(mutex_);
+          tables_.push_back(table);
+        }
+
+        // The counts of an exiting thread are kept.
+        void detach(call_site_table *table)
+        {
+          std::lock_guard<std::mutex> const lock(mutex_);
+          table->add_to(exited_);
+          exited_dropped_ += table->dropped_.load(std::memory_order_relaxed);
+          tables_.erase(std::find(tables_.begin(), tables_.end(), table));
+        }
+
+        std::uint64_t collect(std::map<key, call_site_counts> &sites)
+        {
+          std::lock_guard<std::mutex> const lock(mutex_);
+          std::uint64_t dropped = exited_dropped_;
+          for (auto const &[k, c] : exited_) { add(sites, k, c); }
+          for (call_site_table const *table : tables_) {
+            table->add_to(sites);
+            dropped += table->dropped_.load(std::memory_order_relaxed);
+          }
+          return dropped;
+        }
+
+        void reset()
+        {
+          std::lock_guard<std::mutex> const lock(mutex_);
+          exited_.clear();
+          exited_dropped_ = 0;
+          for (call_site_table *table : tables_) { table->clear(); }
+        }
+
+      private:
+        std::mutex mutex_;
+        std::vector<call_site_table *> tables_;
+        std::map<key, call_site_counts> exited_;
+        std::uint64_t exited_dropped_ = 0;
+      };
+
+      // Never destroyed, threads may exit after the static destructors ran.
+      static table_registry &registry()
+      {
+        static auto *const instance = new table_registry;
+        return *instance;
+      }
+
+      slot slots_[call_site_capacity];
+      slot *last_ = nullptr;
+      std::atomic<std::uint64_t> dropped_{ 0 };
+    };
+
+    inline void record_call_site(call_site_event event,
+      std::source_location const &location) noexcept
+    {
+      MP_CALL_SITE_PROBE(event, location);
+#if defined(MP_CALL_SITE_COUNTERS)
+      call_site_table::local().count(event, location);
+#else
+      (void)event;
+      (void)location;
+#endif
+    }
+
+    inline void write_json_string(std::FILE *out, char const *text)
+    {
+      (void)std::fputc('"', out);
+      for (; *text != '\0'; ++text) {
+        auto const c = static_cast<unsigned char>(*text);
+        if (c == '"' || c == '\\') {
+          (void)std::fputc('\\', out);
+          (void)std::fputc(c, out);
+        } else if (c < 0x20U) {
+          // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+          (void)std::fprintf(out, "\\u%04x", static_cast<unsigned>(c));
+        } else {
+          (void)std::fputc(c, out);
+        }
+      }
+      (void)std::fputc('"', out);
+    }
+
+    inline void write_csv_string(std::FILE *out, char const *text)
+    {
+      (void)std::fputc('"', out);
+      for (; *text != '\0'; ++text) {
+        if (*text == '"') { (void)std::fputc('"', out); }
+        (void)std::fputc(*text, out);
+      }
+      (void)std::fputc('"', out);
+    }
+  }// namespace details
+
+  MP_BEGIN_EXPORT
+
+  // The counts of every call site since the start, or the last reset, in
+  // file, line and column order.
+  [[nodiscard]] inline std::vector<call_site_counts> call_site_snapshot()
+  {
+    std::vector<call_site_counts> result;
+#if defined(MP_CALL_SITE_COUNTERS)
+    std::map<details::call_site_table::key, call_site_counts> sites;
+    (void)details::call_site_table::collect(sites);
+    result.reserve(sites.size());
+    for (auto const &[k, c] : sites) { result.push_back(c); }
+#endif
+    return result;
+  }
+
+  // Calls of sites that did not fit in the table of their thread.
+  [[nodiscard]] inline std::uint64_t call_sites_dropped()
+  {
+#if defined(MP_CALL_SITE_COUNTERS)
+    std::map<details::call_site_table::key, call_site_counts> sites;
+    return details::call_site_table::collect(sites);
+#else
+    return 0;
+#endif
+  }
+
+  // Sets every count to zero.  An event counted by another thread while
+  // resetting may be kept.
+  inline void reset_call_sites()
+  {
+#if defined(MP_CALL_SITE_COUNTERS)
+    details::call_site_table::reset();
+#endif
+  }
+
+  // A JSON array with an object per site.
+  inline void write_call_sites_json(std::FILE *out,
+    std::vector<call_site_counts> const &sites)
+  {
+    (void)std::fputs("[", out);
+    char const *separator = "\n";
+    for (call_site_counts const &site : sites) {
+      (void)std::fputs(separator, out);
+      (void)std::fputs("  {\"file\": ", out);
+      details::write_json_string(out, site.file);
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+      (void)std::fprintf(out,
+        ", \"line\": %lu, \"column\": %lu, \"function\": ",
+        static_cast<unsigned long>(site.line),
+        static_cast<unsigned long>(site.column));
+      details::write_json_string(out, site.function);
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+      (void)std::fprintf(out,
+        ", \"calls\": %llu, \"null_branches\": %llu, \"violations\": %llu}",
+        static_cast<unsigned long long>(site.calls),
+        static_cast<unsigned long long>(site.null_branches),
+        static_cast<unsigned long long>(site.violations));
+      separator = ",\n";
+    }
+    (void)std::fputs(sites.empty() ? "]\n" : "\n]\n", out);
+  }
+
+  // A CSV table with a header line and a line per site.
+  inline void write_call_sites_csv(std::FILE *out,
+    std::vector<call_site_counts> const &sites)
+  {
+    (void)std::fputs(
+      "file,line,column,function,calls,null_branches,violations\n", out);
+    for (call_site_counts const &site : sites) {
+      details::write_csv_string(out, site.file);
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+      (void)std::fprintf(out,
+        ",%lu,%lu,",
+        static_cast<unsigned long>(site.line),
+        static_cast<unsigned long>(site.column));
+      details::write_csv_string(out, site.function);
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+      (void)std::fprintf(out,
+        ",%llu,%llu,%llu\n",
+        static_cast<unsigned long long>(site.calls),
+        static_cast<unsigned long long>(site.null_branches),
+        static_cast<unsigned long long>(site.violations));
+    }
+  }
+
+  MP_END_EXPORT
+}// namespace pointers
+}// namespace marcpawl
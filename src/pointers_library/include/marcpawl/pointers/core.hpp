@@ -0,0 +1,2387 @@
+#pragma once
+
+// The pointer wrappers, without their stream output.  Include io.hpp to
+// print them, or ptr.hpp for both.
+
+#include <atomic>
+#include <cinttypes>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <source_location>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// MP_ASSUME(cond) tells the optimizer that cond holds, without testing it.
+// cond must not have side effects.
+#if defined(__has_cpp_attribute) && __has_cpp_attribute(assume) >= 202207L
+#define MP_ASSUME(cond) [[assume(cond)]]
+#elif defined(__clang__)
+#define MP_ASSUME(cond) __builtin_assume(cond)
+#elif defined(_MSC_VER)
+#define MP_ASSUME(cond) __assume(cond)
+#elif defined(__GNUC__)
+#define MP_ASSUME(cond)                          \
+  do {                                           \
+    if (!(cond)) { __builtin_unreachable(); }    \
+  } while (false)
+#else
+#define MP_ASSUME(cond) ((void)0)
+#endif
+
+// MP_COLD marks a failure path: kept out of line, and out of the hot code of
+// its callers.
+#if defined(__GNUC__)
+#define MP_COLD [[gnu::cold, gnu::noinline]]
+#elif defined(_MSC_VER)
+#define MP_COLD __declspec(noinline)
+#else
+#define MP_COLD
+#endif
+
+// MP_EXPECT(cond, expected, probability) is cond, with the hint that it is
+// expected, true or false, with the given probability.
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_expect_with_probability)
+#define MP_EXPECT(cond, expected, probability)                          \
+  (__builtin_expect_with_probability(                                   \
+     static_cast<long>(cond), static_cast<long>(expected), probability) \
+    != 0)
+#endif
+#endif
+#if !defined(MP_EXPECT) && defined(__GNUC__)
+#define MP_EXPECT(cond, expected, probability)                           \
+  (__builtin_expect(static_cast<long>(cond), static_cast<long>(expected)) \
+    != 0)
+#elif !defined(MP_EXPECT)
+#define MP_EXPECT(cond, expected, probability) (static_cast<bool>(cond))
+#endif
+
+// MP_NO_EXCEPTIONS builds without exceptions.  It is defined when the
+// compiler has exceptions turned off, e.g. -fno-exceptions.
+#if !defined(MP_NO_EXCEPTIONS) && !defined(__cpp_exceptions)
+#define MP_NO_EXCEPTIONS
+#endif
+
+// What a failed null check does, chosen by defining MP_NULL_POLICY to one
+// of:
+//
+//   MP_NULL_POLICY_THROW      throws nullptr_exception, the default
+//   MP_NULL_POLICY_TERMINATE  calls the null violation handler, then
+//                             std::terminate(); the default with
+//                             MP_NO_EXCEPTIONS
+//   MP_NULL_POLICY_OBSERVE    calls the null violation handler, and carries
+//                             on with the null pointer
+//   MP_NULL_POLICY_UNCHECKED  MP_NULL_POLICY_TERMINATE, but with NDEBUG
+//                             defined nothing is tested at all
+#define MP_NULL_POLICY_THROW 1
+#define MP_NULL_POLICY_TERMINATE 2
+#define MP_NULL_POLICY_OBSERVE 3
+#define MP_NULL_POLICY_UNCHECKED 4
+
+#if !defined(MP_NULL_POLICY)
+#if defined(MP_NO_EXCEPTIONS)
+#define MP_NULL_POLICY MP_NULL_POLICY_TERMINATE
+#else
+#define MP_NULL_POLICY MP_NULL_POLICY_THROW
+#endif
+#endif
+
+#if MP_NULL_POLICY == MP_NULL_POLICY_THROW && defined(MP_NO_EXCEPTIONS)
+#error "MP_NULL_POLICY_THROW needs exceptions"
+#endif
+
+// The declarations between MP_BEGIN_EXPORT and MP_END_EXPORT are those that
+// the marcpawl.pointers module exports, see module/marcpawl.pointers.cppm,
+// which defines MP_MODULE.  The details namespaces are left out.
+#if defined(MP_MODULE)
+#define MP_BEGIN_EXPORT export {
+#define MP_END_EXPORT }
+#else
+#define MP_BEGIN_EXPORT
+#define MP_END_EXPORT
+#endif
+
+namespace marcpawl {
+namespace pointers {
+  MP_BEGIN_EXPORT
+  template<typename T> class intrusive_ptr;
+  template<typename T, std::signed_integral Offset> class basic_self_relative;
+
+  MP_END_EXPORT
+
+  namespace details {
+    // Resolves to the more efficient of `const T` or `const T&`, in the context
+    // of returning a const-qualified value of type T.
+    //
+    // Copied from cppfront's implementation of the CppCoreGuidelines F.16
+    // (https://isocpp.github.io/CppCoreGuidelines/CppCoreGuidelines#Rf-in)
+    //
+    // Copied from
+    // https://github.com/microsoft/GSL/blob/main/include/gsl/pointers
+    // User MIT license
+    template<typename T>
+    using value_or_reference_return_t =
+      std::conditional_t<sizeof(T) < 2 * sizeof(void *)
+                           && std::is_trivially_copy_constructible<T>::value,
+        T const,
+        T const &>;
+
+    template<typename T, typename U>
+    concept EqualityComparable = requires(T a, U b) {
+      { a == b } -> std::convertible_to<bool>;
+    };
+
+    template<typename T, typename U>
+    concept Comparable = requires(T a, U b) {
+      { a < b } -> std::convertible_to<bool>;
+    };
+
+    template<typename T>
+    concept IsUniquePtr = requires {
+      typename T::element_type;// Check if T has an element_type
+                               // (std::unique_ptr has this)
+    } && std::is_same_v<T, std::unique_ptr<typename T::element_type>>;
+
+    template<typename T>
+    concept IsSharedPtr = requires {
+      typename T::element_type;// Check if T has an element_type
+                               // (std::shared_ptr has this)
+    } && std::is_same_v<T, std::shared_ptr<typename T::element_type>>;
+
+    template<typename T> struct is_intrusive_ptr : std::false_type
+    {
+    };
+    template<typename T>
+    struct is_intrusive_ptr<intrusive_ptr<T>> : std::true_type
+    {
+    };
+
+    template<typename T>
+    concept IsIntrusivePtr = is_intrusive_ptr<T>::value;
+
+    template<typename T> struct is_self_relative : std::false_type
+    {
+    };
+    template<typename T, std::signed_integral Offset>
+    struct is_self_relative<basic_self_relative<T, Offset>> : std::true_type
+    {
+    };
+
+    template<typename T>
+    concept IsSelfRelative = is_self_relative<T>::value;
+
+    // The pointer that maybe_null hands out for T, to the handlers of visit
+    // and in the results of its conversions.  A self relative pointer is
+    // decoded: a copy of it on the stack may be too far from its target to
+    // be encoded.
+    template<typename T> struct not_null_pointer
+    {
+      using type = T;
+    };
+    template<IsSelfRelative T> struct not_null_pointer<T>
+    {
+      using type = typename T::element_type *;
+    };
+
+    template<typename T>
+    using not_null_pointer_t = typename not_null_pointer<T>::type;
+
+    // Raw pointers are accepted without looking at the pointee, so that a
+    // class template can hold a wrapped pointer to itself while it is still
+    // incomplete.
+    template<typename T>
+    concept RawPointer =
+      std::is_pointer_v<T> && !std::is_void_v<std::remove_pointer_t<T>>;
+
+    template<typename T>
+    concept Pointer = RawPointer<T> || requires(T p) {
+      *p;// T must be dereferenceable
+      {
+        p == nullptr
+      } -> std::convertible_to<bool>;// T must be comparable to nullptr
+    };
+
+    template<typename T>
+    concept not_nullptr =
+      !std::is_same_v<std::remove_cv_t<std::remove_reference_t<T>>,
+        std::nullptr_t>;
+
+    template<typename T>
+    concept IsUnManagedPtr =
+      Pointer<T> && (!IsUniquePtr<T>) && (!IsSharedPtr<T>)
+      && (!IsIntrusivePtr<T>) && not_nullptr<T>;
+
+    // The raw pointer held by p through any wrappers, e.g. B * for a
+    // maybe_null<B *>, a std::unique_ptr<B> or a compressed_ptr<B>.
+    template<typename P> constexpr auto raw_pointer_of(P const &p) noexcept
+    {
+      if constexpr (std::is_pointer_v<P>) {
+        return p;
+      } else if constexpr (requires { p.ptr_; }) {
+        return raw_pointer_of(p.ptr_);
+      } else {
+        return p.get();
+      }
+    }
+
+  }// namespace details
+
+  MP_BEGIN_EXPORT
+
+  template<typename T>
+  concept Nullable = requires(T t) { t = nullptr; };
+
+  template<typename T>
+  concept VoidComparable = requires(T t, void *p) { t == p; };
+
+  // Selects the constructor of strict_not_null that trusts the caller, for
+  // a pointer that is already known not to be null, e.g. it has just been
+  // tested:
+  //
+  //   if (p != nullptr) { use(strict_not_null<T *>{ assume_not_null, p }); }
+  //
+  // The pointer is not tested again, and the optimizer is told that it is
+  // not null so that later tests fold away.  Passing null is undefined
+  // behaviour.
+  struct assume_not_null_t
+  {
+    explicit assume_not_null_t() = default;
+  };
+  inline constexpr assume_not_null_t assume_not_null{};
+
+  template<details::Pointer T> class maybe_null;
+  template<details::Pointer T> class strict_not_null;
+  template<details::Pointer T> class owner;
+  template<details::Pointer T> class borrower;
+  template<details::RawPointer T> class optional_not_null;
+  template<details::RawPointer T> class variant_not_null;
+
+  template<typename F>
+  concept nullptr_handler = std::invocable<F, std::nullptr_t>;
+
+  template<typename F, typename T>
+  concept not_null_handler =
+    std::invocable<F, strict_not_null<details::not_null_pointer_t<T>>>;
+
+  // How often a maybe_null is expected to be null where it is tested, for
+  // maybe_null#visit and the conversions of maybe_null:
+  //
+  //   node.visit<likely_not_null>(on_leaf, on_node);
+  //
+  // The test is weighted, with __builtin_expect_with_probability where
+  // there is one, and the handler of the unlikely branch is called out of
+  // line and marked cold, so that the likely branch is straight line code.
+  // unknown leaves the layout to the compiler.
+  enum class null_likelihood { unknown, likely_not_null, likely_null };
+
+  inline constexpr null_likelihood likely_not_null =
+    null_likelihood::likely_not_null;
+  inline constexpr null_likelihood likely_null = null_likelihood::likely_null;
+
+  template<details::Pointer T> class wrapped_pointer;
+
+
+  // A null pointer where there must not be one.  Nothing is allocated, so
+  // that it can be thrown, or reported, when memory is exhausted: the
+  // message must outlive the exception, e.g. a string literal.
+  class nullptr_exception : public std::exception
+  {
+  public:
+    explicit nullptr_exception() noexcept = default;
+    explicit nullptr_exception(char const *message,
+      std::source_location location = std::source_location::current()) noexcept
+      : message_(message), location_(location)
+    {}
+    ~nullptr_exception() noexcept override = default;
+
+    [[nodiscard]] char const *what() const noexcept override
+    {
+      return message_;
+    }
+
+    // Where the null pointer was found.
+    [[nodiscard]] std::source_location const &location() const noexcept
+    {
+      return location_;
+    }
+
+  private:
+    char const *message_ = "";
+    std::source_location location_;
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Null violations
+  //
+  // The failure path of every null check, see MP_NULL_POLICY.  The handler
+  // is called by MP_NULL_POLICY_TERMINATE and MP_NULL_POLICY_OBSERVE, from
+  // any thread; the default one prints the violation to stderr.
+  ////////////////////////////////////////////////////////////////////////////
+  using null_violation_handler = void (*)(nullptr_exception const &) noexcept;
+
+  enum class null_policy { throw_exception, terminate, observe, unchecked };
+
+  MP_END_EXPORT
+
+  namespace details {
+    inline constexpr null_policy active_null_policy =
+#if MP_NULL_POLICY == MP_NULL_POLICY_THROW
+      null_policy::throw_exception;
+#elif MP_NULL_POLICY == MP_NULL_POLICY_TERMINATE
+      null_policy::terminate;
+#elif MP_NULL_POLICY == MP_NULL_POLICY_OBSERVE
+      null_policy::observe;
+#elif MP_NULL_POLICY == MP_NULL_POLICY_UNCHECKED
+      null_policy::unchecked;
+#else
+#error "MP_NULL_POLICY is not one of the MP_NULL_POLICY_ values"
+#endif
+
+    inline void print_null_violation(
+      nullptr_exception const &violation) noexcept
+    {
+      std::source_location const &where = violation.location();
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+      (void)std::fprintf(stderr,
+        "%s:%" PRIuLEAST32 ": %s: null pointer: %s\n",
+        where.file_name(),
+        where.line(),
+        where.function_name(),
+        violation.what());
+    }
+
+    inline std::atomic<null_violation_handler> null_violation_handler_{
+      &print_null_violation
+    };
+
+    inline void report_null_violation(char const *message,
+      std::source_location const &location) noexcept
+    {
+      null_violation_handler_.load(std::memory_order_acquire)(
+        nullptr_exception(message, location));
+    }
+
+#if MP_NULL_POLICY == MP_NULL_POLICY_OBSERVE
+    MP_COLD inline void null_violation(char const *message,
+      std::source_location const &location) noexcept
+    {
+      report_null_violation(message, location);
+    }
+#else
+    [[noreturn]] MP_COLD inline void null_violation(char const *message,
+      std::source_location const &location)
+    {
+#if MP_NULL_POLICY == MP_NULL_POLICY_THROW
+      throw nullptr_exception(message, location);
+#else
+      report_null_violation(message, location);
+      std::terminate();
+#endif
+    }
+#endif
+
+    // A null violation that cannot be carried on from, e.g. a null key of a
+    // pointer_set: terminates even with MP_NULL_POLICY_OBSERVE.
+    [[noreturn]] MP_COLD inline void fatal_null_violation(char const *message,
+      std::source_location const &location)
+    {
+      null_violation(message, location);
+      std::terminate();
+    }
+
+    // Whether a failed null check leaves by an exception.
+    inline constexpr bool null_violation_throws =
+      active_null_policy == null_policy::throw_exception;
+
+    // See call_sites.hpp.
+    enum class call_site_event : unsigned char { call, null_branch, violation };
+
+#if defined(MP_CALL_SITE_COUNTERS) || defined(MP_CALL_SITE_PROBES)
+    inline void record_call_site(call_site_event event,
+      std::source_location const &location) noexcept;
+#endif
+
+    constexpr void count_call_site(call_site_event event,
+      std::source_location const &location) noexcept
+    {
+#if defined(MP_CALL_SITE_COUNTERS) || defined(MP_CALL_SITE_PROBES)
+      if (!std::is_constant_evaluated()) { record_call_site(event, location); }
+#else
+      (void)event;
+      (void)location;
+#endif
+    }
+
+    template<typename T>
+    constexpr void check_not_null(T const &ptr,
+      char const *message,
+      std::source_location const &location) noexcept(!null_violation_throws)
+    {
+#if MP_NULL_POLICY == MP_NULL_POLICY_UNCHECKED && defined(NDEBUG)
+      // Unchecked at run time, a compile error during constant evaluation.
+      if (std::is_constant_evaluated() && ptr == nullptr) {
+        null_violation(message, location);
+      }
+#else
+      count_call_site(call_site_event::call, location);
+      if (ptr == nullptr) [[unlikely]] {
+        count_call_site(call_site_event::violation, location);
+        null_violation(message, location);
+      }
+#endif
+    }
+
+    // The probability of the likely branch of a null_likelihood.
+    inline constexpr double likely_branch_probability = 0.999;
+
+    // is_null, weighted by Likelihood.
+    template<null_likelihood Likelihood>
+    constexpr bool expect_null(bool is_null) noexcept
+    {
+      if constexpr (Likelihood == null_likelihood::unknown) {
+        return is_null;
+      } else {
+        return MP_EXPECT(is_null,
+          Likelihood == null_likelihood::likely_null,
+          likely_branch_probability);
+      }
+    }
+
+    template<typename F, typename Arg>
+    MP_COLD constexpr decltype(auto) call_cold(F &handler, Arg &&arg)
+    {
+      return handler(std::forward<Arg>(arg));
+    }
+
+    // Calls handler, out of line when it handles the unlikely branch.
+    template<bool Cold, typename F, typename Arg>
+    constexpr decltype(auto) call_handler(F &handler, Arg &&arg)
+    {
+      if constexpr (Cold) {
+        return call_cold(handler, std::forward<Arg>(arg));
+      } else {
+        return handler(std::forward<Arg>(arg));
+      }
+    }
+
+    // Throws E, or terminates without exceptions.  Out of line, so that
+    // the caller only has a call on its failure path.
+    template<typename E>
+    [[noreturn]] MP_COLD inline void raise(char const *message)
+    {
+#if defined(MP_NO_EXCEPTIONS)
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+      (void)std::fprintf(stderr, "%s\n", message);
+      std::terminate();
+#else
+      if constexpr (std::is_constructible_v<E, char const *>) {
+        throw E(message);
+      } else {
+        (void)message;
+        throw E();
+      }
+#endif
+    }
+  }// namespace details
+
+  MP_BEGIN_EXPORT
+
+  // Replaces the handler of null violations, nullptr for the default one,
+  // and returns the previous one.
+  inline null_violation_handler set_null_violation_handler(
+    null_violation_handler handler) noexcept
+  {
+    if (handler == nullptr) { handler = &details::print_null_violation; }
+    return details::null_violation_handler_.exchange(
+      handler, std::memory_order_acq_rel);
+  }
+
+  [[nodiscard]] inline null_violation_handler
+    get_null_violation_handler() noexcept
+  {
+    return details::null_violation_handler_.load(std::memory_order_acquire);
+  }
+
+  MP_END_EXPORT
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Borrow checks
+  //
+  // With MP_BORROW_CHECKS defined, a borrower that outlives the object of
+  // its owner is a violation, reported by borrower#operator-> and
+  // borrower#operator* through the null violation handler, see
+  // MP_NULL_POLICY:
+  //
+  //   owner<Node *> node = make_owner(new Node);
+  //   borrower<Node *> view(node);
+  //   delete_owned(std::move(node));
+  //   view->value;// violation
+  //
+  // Every address given to an owner<T *> has a generation in a side table,
+  // odd while the object lives, even once it ended.  The owner keeps the
+  // slot and the generation, a borrower copies them from its owner, and
+  // its operator-> compares the generation with the one in the slot, a
+  // single load.  Only a borrower made from a pointer looks its object up.
+  // The address is the raw pointer under any wrappers, e.g. that of an
+  // owner<strict_not_null<T *>>.
+  //
+  // A lifetime ends with delete_owned(), size_class_pool::release(),
+  // arena::release() and the deletion of an object retired to a
+  // hazard_domain or an epoch_domain.  Call end_borrows() when it ends
+  // another way.
+  //
+  // The table is split into shards of open addressing slots, updated
+  // without locks.  The objects of a 4 KiB page share a shard and get
+  // neighbouring slots, so that the checks of objects allocated together
+  // load the same cache lines.  MP_BORROW_TABLE_CAPACITY sets the number of
+  // slots.
+  //
+  // The slot of an ended lifetime is taken over by the next address that
+  // needs one, and the generation carries on from where it was, so that a
+  // stale borrower never matches the new object.  A slot whose 16 bit
+  // generation runs out is retired for good rather than wrapping around.
+  // An address that finds no slot is not tracked, and its borrowers are
+  // not checked: borrows_untracked() and borrow_slots_retired() count both.
+  //
+  // This is a debug mode, it does not fit a 5% budget for canaries.  Each
+  // check is a load from the side table: walks over large, cold data barely
+  // notice it, but loops over cache resident objects run about 2 to 4 times
+  // slower, see borrow_check_benchmarks.
+  //
+  // A borrower and an owner are larger than their pointer in this mode, so
+  // MP_BORROW_CHECKS must be the same for the whole program.  Without it
+  // nothing is tracked and nothing is tested.
+  ////////////////////////////////////////////////////////////////////////////
+  namespace details {
+    inline constexpr bool borrow_checks =
+#if defined(MP_BORROW_CHECKS)
+      true;
+#else
+      false;
+#endif
+
+#if defined(MP_BORROW_CHECKS)
+#if !defined(MP_BORROW_TABLE_CAPACITY)
+#define MP_BORROW_TABLE_CAPACITY (1U << 18U)
+#endif
+
+    inline constexpr std::size_t borrow_shard_count = 64;
+    inline constexpr std::size_t borrow_shard_capacity =
+      MP_BORROW_TABLE_CAPACITY / borrow_shard_count;
+    static_assert(borrow_shard_capacity > 0
+                    && (borrow_shard_capacity & (borrow_shard_capacity - 1))
+                         == 0,
+      "MP_BORROW_TABLE_CAPACITY must be a power of two of at least 64");
+    inline constexpr std::size_t borrow_slot_count =
+      borrow_shard_count * borrow_shard_capacity;
+    static_assert(borrow_slot_count < 0xffff'ffffU,
+      "MP_BORROW_TABLE_CAPACITY must fit in 32 bits");
+
+    // A slot is the low 48 bits of an address and a 16 bit generation, in
+    // one word so that a check is one load.  0 is a free slot.  The shards
+    // follow each other, and the slot after the last one stays 0: it is
+    // the slot of the objects that are not tracked.
+    alignas(64) inline std::atomic<std::uint64_t>
+      borrow_slots[borrow_slot_count + 1];
+
+    inline std::atomic<std::uint64_t> borrows_untracked_{ 0 };
+    inline std::atomic<std::uint64_t> borrow_slots_retired_{ 0 };
+
+    class borrow_table
+    {
+    public:
+      using generation_type = std::uint16_t;
+
+      // The slot of an address and the generation it had, all that a check
+      // needs.  A generation of 0 is not tracked, and always matches the
+      // last slot.  Both are 32 bits, so that a stamp without padding is
+      // copied as one word.
+      struct stamp_type
+      {
+        std::uint32_t slot = untracked;
+        std::uint32_t generation = 0;
+      };
+
+      // Slots looked at before an address is given up on.
+      static constexpr std::size_t max_probe = 64;
+
+      // The address is alive, from now on if it was not.
+      static stamp_type begin(void const volatile *address) noexcept
+      {
+        if (address == nullptr) { return {}; }
+        std::uint64_t const key = key_of(address);
+        for (;;) {
+          probe const found = find(address);
+          std::uint32_t const index =
+            found.index != untracked ? found.index : found.free;
+          if (index == untracked) {
+            borrows_untracked_.fetch_add(1, std::memory_order_relaxed);
+            return {};
+          }
+          slot &s = borrow_slots[index];
+          std::uint64_t word = s.load(std::memory_order_relaxed);
+          // Probes again when another address took the slot meanwhile.
+          while ((word & ~generation_mask) == key || is_free(word)) {
+            if ((word & ~generation_mask) == key && (word & 1U) != 0) {
+              return { index, generation(word) };
+            }
+            std::uint64_t const next = key | (generation(word) + 1U);
+            if (s.compare_exchange_weak(word,
+                  next,
+                  std::memory_order_acq_rel,
+                  std::memory_order_relaxed)) {
+              return { index, generation(next) };
+            }
+          }
+        }
+      }
+
+      static void end(void const volatile *address) noexcept
+      {
+        if (address == nullptr) { return; }
+        std::uint64_t const key = key_of(address);
+        std::uint32_t const index = find(address).index;
+        if (index == untracked) { return; }
+        slot &s = borrow_slots[index];
+        std::uint64_t word = s.load(std::memory_order_relaxed);
+        while ((word & ~generation_mask) == key && (word & 1U) != 0) {
+          bool const last = generation(word) == generation_mask;
+          if (s.compare_exchange_weak(word,
+                last ? retired : word + 1U,
+                std::memory_order_release,
+                std::memory_order_relaxed)) {
+            if (last) {
+              borrow_slots_retired_.fetch_add(1, std::memory_order_relaxed);
+            }
+            return;
+          }
+        }
+      }
+
+      // The stamp of a live address, not tracked otherwise.
+      [[nodiscard]] static stamp_type stamp(
+        void const volatile *address) noexcept
+      {
+        if (address == nullptr) { return {}; }
+        std::uint32_t const index = find(address).index;
+        if (index == untracked) { return {}; }
+        std::uint64_t const word =
+          borrow_slots[index].load(std::memory_order_acquire);
+        if ((word & ~generation_mask) != key_of(address) || (word & 1U) == 0) {
+          return {};
+        }
+        return { index, generation(word) };
+      }
+
+      // One load, the slot of an address never changes.
+      [[nodiscard]] static bool alive(stamp_type stamped) noexcept
+      {
+        return generation(
+                 borrow_slots[stamped.slot].load(std::memory_order_acquire))
+               == stamped.generation;
+      }
+
+    private:
+      using slot = std::atomic<std::uint64_t>;
+
+      static constexpr std::uint64_t generation_mask = 0xffffU;
+      static constexpr auto untracked =
+        static_cast<std::uint32_t>(borrow_slot_count);
+      // No address has these 48 bits, and a generation of 0 matches no
+      // stamp of a tracked object.
+      static constexpr std::uint64_t retired = ~generation_mask;
+
+      // The slot of the address, or untracked, and the first slot it could
+      // take, or untracked.
+      struct probe
+      {
+        std::uint32_t index = untracked;
+        std::uint32_t free = untracked;
+      };
+
+      static constexpr generation_type generation(std::uint64_t word) noexcept
+      {
+        return static_cast<generation_type>(word & generation_mask);
+      }
+
+      static std::uint64_t key_of(void const volatile *address) noexcept
+      {
+        return (reinterpret_cast<std::uintptr_t>(address) & 0xffff'ffff'ffffULL)
+               << 16U;
+      }
+
+      // Never used, or used by an object whose lifetime ended.
+      static constexpr bool is_free(std::uint64_t word) noexcept
+      {
+        return (word & 1U) == 0 && word != retired;
+      }
+
+      // An address is never past a slot that was never used, slots are
+      // taken over but never emptied.
+      static probe find(void const volatile *address) noexcept
+      {
+        std::uint64_t const bits = reinterpret_cast<std::uintptr_t>(address);
+        std::uint64_t const key = key_of(address);
+        std::uint64_t const hash = (bits >> 12U) * 0x9e3779b97f4a7c15ULL;
+        // The top 6 bits select one of the 64 shards, the 16 bytes of the
+        // page the first slot in the run of the page.
+        std::size_t const shard = hash >> 58U;
+        std::uint64_t const start = (hash >> 20U) + ((bits >> 4U) & 0xffU);
+        probe found;
+        for (std::uint64_t i = 0; i < max_probe; ++i) {
+          auto const index = static_cast<std::uint32_t>(
+            shard * borrow_shard_capacity
+            + ((start + i) & (borrow_shard_capacity - 1)));
+          std::uint64_t const word =
+            borrow_slots[index].load(std::memory_order_acquire);
+          if ((word & ~generation_mask) == key) {
+            found.index = index;
+            return found;
+          }
+          if (is_free(word) && found.free == untracked) { found.free = index; }
+          if (word == 0) { break; }
+        }
+        return found;
+      }
+    };
+
+    // Objects are not tracked during constant evaluation, a borrower made
+    // then is never checked.
+    template<typename P>
+    constexpr borrow_table::stamp_type borrow_stamp(P const &p) noexcept
+    {
+      if (std::is_constant_evaluated()) { return {}; }
+      return borrow_table::stamp(raw_pointer_of(p));
+    }
+
+    // The stamp of a borrower or an owner, for the classes that keep the
+    // pointer of one in another form, e.g. tagged.
+    struct borrow_access;
+
+    MP_COLD inline void dangling_borrower(
+      std::source_location const &location) noexcept(!null_violation_throws)
+    {
+      count_call_site(call_site_event::violation, location);
+      null_violation("borrower used after the lifetime of its owner", location);
+    }
+#endif
+  }// namespace details
+
+  MP_BEGIN_EXPORT
+
+  // The lifetime of the object at address ended another way than with
+  // delete_owned(), see MP_BORROW_CHECKS.
+  constexpr void end_borrows(
+    [[maybe_unused]] void const volatile *address) noexcept
+  {
+#if defined(MP_BORROW_CHECKS)
+    if (!std::is_constant_evaluated()) { details::borrow_table::end(address); }
+#endif
+  }
+
+  // Owners whose address found no slot, so that their borrowers are not
+  // checked, see MP_BORROW_CHECKS.  0 without it.
+  [[nodiscard]] inline std::uint64_t borrows_untracked() noexcept
+  {
+#if defined(MP_BORROW_CHECKS)
+    return details::borrows_untracked_.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+  }
+
+  // Slots retired because their generation ran out, see MP_BORROW_CHECKS.
+  // 0 without it.
+  [[nodiscard]] inline std::uint64_t borrow_slots_retired() noexcept
+  {
+#if defined(MP_BORROW_CHECKS)
+    return details::borrow_slots_retired_.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // wrapped_pointer
+  //
+  // Pointer that will reject use as a non-single type.
+  // If the type is not single, use std::span.
+  //
+  // Copy, move and destruction are left to the compiler, so that when T is a
+  // raw pointer every wrapper is trivially copyable and trivially
+  // destructible, and is passed and returned in a register like T.
+  //
+  // There is no common base class: a wrapper of a wrapper, e.g.
+  // borrower<strict_not_null<T *>>, would then hold it twice and could not
+  // have the size of T.
+  //
+  // Every operation on a raw pointer is constexpr, so that tables of
+  // wrappers can be constinit and need no dynamic initialisation:
+  //
+  //   constinit std::array<strict_not_null<Handler const *>, 2> handlers{
+  //     constant_not_null(&on_open), constant_not_null(&on_close)
+  //   };
+  //
+  // A null violation during constant evaluation is a compile error, with
+  // every MP_NULL_POLICY.
+  ////////////////////////////////////////////////////////////////////////////
+
+  template<details::Pointer T> class wrapped_pointer
+  {
+  public:
+    T ptr_;
+
+  public:
+    constexpr wrapped_pointer() : ptr_(nullptr) {}
+    constexpr wrapped_pointer(T const &ptr)
+      requires std::is_copy_constructible_v<T>
+      : ptr_(ptr)
+    {}
+
+    constexpr wrapped_pointer(T &&ptr)
+      requires std::is_move_constructible_v<T>
+      : ptr_(std::move(ptr))
+    {}
+
+    // Builds T from u in place rather than moving it from a temporary, for
+    // pointers whose value depends on where they are stored, e.g.
+    // compressed_ptr.
+    template<typename U>
+      requires std::is_constructible_v<T, U &&>
+    constexpr wrapped_pointer(std::in_place_t, U &&u)
+      : ptr_(std::forward<U>(u))
+    {}
+
+    // Use get().  Deleted to avoid conversion to raw pointer,
+    // and then construction into a different wrapped pointer
+    // type, avoiding the type check.
+    // operator T() const  = delete;
+
+    constexpr details::value_or_reference_return_t<T> get() const
+    {
+      return ptr_;
+    }
+
+
+    // Define three-way comparison for wrapped_pointer and wrapped_pointer
+    constexpr auto operator<=>(wrapped_pointer const &other) const
+    {
+      return ptr_ <=> other.ptr_;
+    }
+
+
+    // // Define three-way comparison for wrapped_pointer<T> and
+    // wrapped_pointer<U> template <typename U> auto operator<=>(const
+    // wrapped_pointer<U>& rhs) const {
+    //     // Implement comparison logic for wrapped_pointer<T> and
+    //     wrapped_pointer<U> return ptr_ <=> rhs;
+    // }
+
+    // unwanted operators...pointers only point to single objects!
+    wrapped_pointer &operator++() = delete;
+    wrapped_pointer &operator--() = delete;
+    wrapped_pointer operator++(int) = delete;
+    wrapped_pointer operator--(int) = delete;
+    wrapped_pointer &operator+=(std::ptrdiff_t) = delete;
+    wrapped_pointer &operator-=(std::ptrdiff_t) = delete;
+    void operator[](std::ptrdiff_t) const = delete;
+  };
+
+
+  template<typename T>
+  constexpr auto operator<(wrapped_pointer<T> const &lhs, void *rhs)
+  {
+    return lhs.get() < rhs;
+  }
+
+  template<typename T>
+  constexpr auto operator<=(wrapped_pointer<T> const &lhs, void *rhs)
+  {
+    return lhs.get() <= rhs;
+  }
+
+  template<typename T>
+  constexpr auto operator>=(wrapped_pointer<T> const &lhs, void *rhs)
+  {
+    return lhs.get() >= rhs;
+  }
+
+  template<typename T, typename U>
+  constexpr auto operator>(wrapped_pointer<T> const &lhs,
+    wrapped_pointer<U> const &rhs)
+  {
+    return lhs.get() > rhs.get();
+  }
+
+  template<typename T>
+  constexpr auto operator>(wrapped_pointer<T> const &lhs, void *rhs)
+  {
+    return lhs.get() > rhs;
+  }
+
+  template<typename T, typename U>
+  constexpr auto operator<(wrapped_pointer<T> const &lhs,
+    wrapped_pointer<U> const &rhs)
+  {
+    return lhs.get() < rhs.get();
+  }
+
+  template<typename T>
+  constexpr auto operator<(void const *const lhs, wrapped_pointer<T> const &rhs)
+  {
+    return lhs < rhs.get();
+  }
+
+  template<typename T, typename U>
+  constexpr auto operator<=(wrapped_pointer<T> const &lhs,
+    wrapped_pointer<U> const &rhs)
+  {
+    return lhs.get() <= rhs.get();
+  }
+
+  template<typename T>
+  constexpr auto operator<=(void *lhs, wrapped_pointer<T> const &rhs)
+  {
+    return lhs <= rhs.get();
+  }
+
+  template<typename T, typename U>
+  constexpr auto operator>=(wrapped_pointer<T> const &lhs,
+    wrapped_pointer<U> const &rhs)
+  {
+    return lhs.get() >= rhs.get();
+  }
+
+  template<typename T>
+  constexpr auto operator>=(void *lhs, wrapped_pointer<T> const &rhs)
+  {
+    return lhs >= rhs.get();
+  }
+
+  template<typename T>
+  constexpr auto operator>(void *lhs, wrapped_pointer<T> const &rhs)
+  {
+    return lhs > rhs.get();
+  }
+
+  template<typename T>
+    requires VoidComparable<T>
+  [[nodiscard]] constexpr auto operator==(wrapped_pointer<T> const &lhs,
+    void const *const rhs);
+
+  template<typename T>
+    requires VoidComparable<T>
+  [[nodiscard]] constexpr auto operator==(void const *const lhs,
+    wrapped_pointer<T> const &rhs);
+
+  template<typename T, typename U>
+  [[nodiscard]] constexpr auto operator==(wrapped_pointer<T> const &lhs,
+    wrapped_pointer<U> const &rhs)
+  {
+    auto const &lhs_value = lhs.get();
+    auto const &rhs_value = rhs.get();
+    return lhs_value == rhs_value;
+  }
+
+  template<typename T>
+    requires VoidComparable<T>
+  [[nodiscard]] constexpr auto operator==(wrapped_pointer<T> const &lhs,
+    void const *const rhs)
+  {
+    return lhs.get() == rhs;
+  }
+
+
+  template<typename T>
+    requires VoidComparable<T>
+  [[nodiscard]] constexpr auto operator==(void const *const lhs,
+    wrapped_pointer<T> const &rhs)
+  {
+    return lhs == rhs.get();
+    ;
+  }
+
+  template<typename T>
+  [[nodiscard]] constexpr bool operator!(wrapped_pointer<T> const &ptr) noexcept
+  {
+    return ptr.get() == nullptr;
+  }
+
+  // more unwanted operators
+  template<class T, class U>
+  std::ptrdiff_t operator-(wrapped_pointer<T> const &,
+    wrapped_pointer<U> const &) = delete;
+  template<class T>
+  wrapped_pointer<T> operator-(wrapped_pointer<T> const &,
+    std::ptrdiff_t) = delete;
+  template<class T>
+  wrapped_pointer<T> operator+(wrapped_pointer<T> const &,
+    std::ptrdiff_t) = delete;
+  template<class T>
+  wrapped_pointer<T> operator+(std::ptrdiff_t,
+    wrapped_pointer<T> const &) = delete;
+
+#ifdef TODO
+  template<typename T, typename U>
+    requires(::marcpawl::pointers::details::Comparable<T, U>
+             && ::marcpawl::pointers::details::EqualityComparable<T, U>)
+  auto operator<=(wrapped_pointer<T> const &lhs,
+    wrapped_pointer<U> const &rhs) noexcept
+  {
+    return lhs.get() <= rhs.get();
+  }
+
+  template<typename T, typename U>
+    requires(::marcpawl::pointers::details::Comparable<T, U>)
+  auto operator>(wrapped_pointer<T> const &lhs,
+    wrapped_pointer<U> const &rhs) noexcept
+  {
+    auto l = lhs.get();
+    auto r = rhs.get();
+    return l > r;
+  }
+
+  template<typename T, typename U>
+    requires(::marcpawl::pointers::details::Comparable<T, U>
+             && ::marcpawl::pointers::details::EqualityComparable<T, U>)
+  auto operator>=(wrapped_pointer<T> const &lhs,
+    wrapped_pointer<U> const &rhs) noexcept
+  {
+    return lhs.get() >= rhs.get();
+  }
+#endif
+
+
+  ////////////////////////////////////////////////////////////////////////////
+  // strict_not_null
+  //
+  // Based on gsl::strict_not_null
+  //
+  // Restricts a pointer or smart pointer to only hold non-null values,
+  //
+  // - provides a strict (i.e. explicit constructor from T) wrapper of not_null
+  // - to be used for new code that wishes the design to be cleaner and make
+  // not_null
+  //   checks intentional, or in old code that would like to make the
+  //   transition.
+  //
+  //   To make the transition from not_null, incrementally replace not_null
+  //   by strict_not_null and fix compilation errors
+  //
+  //   Expect to
+  //   - remove all unneeded conversions from raw pointer to not_null and back
+  //   - make API clear by specifying not_null in parameters where needed
+  //   - remove unnecessary asserts
+  //
+  ////////////////////////////////////////////////////////////////////////////
+  template<details::Pointer T> class strict_not_null : public wrapped_pointer<T>
+  {
+
+  public:
+    strict_not_null() = delete;
+
+    // A null u is a null violation, reported at the caller.
+    template<details::Pointer U>
+      requires(!std::is_same_v<std::remove_cvref_t<U>, strict_not_null>)
+    constexpr explicit strict_not_null(U &&u,
+      std::source_location const &location =
+        std::source_location::current())
+      noexcept(std::is_nothrow_move_constructible<T>::value
+               && !details::null_violation_throws)
+      : wrapped_pointer<T>(std::in_place, std::move(u))
+    {
+      details::check_not_null(
+        this->ptr_, "strict_not_null from a null pointer", location);
+    }
+
+    // Not tested, see assume_not_null.
+    constexpr strict_not_null(assume_not_null_t, T ptr) noexcept(
+      std::is_nothrow_move_constructible<T>::value)
+      : wrapped_pointer<T>(std::move(ptr))
+    {
+      assume_invariant();
+    }
+
+
+  public:
+    // Defaulted so that strict_not_null<U*> is trivially copyable.  They are
+    // deleted when T cannot be copied or moved, e.g. std::unique_ptr cannot
+    // be copied.
+    constexpr strict_not_null(strict_not_null const &other) = default;
+    constexpr strict_not_null(strict_not_null &&other) = default;
+    constexpr strict_not_null &operator=(strict_not_null const &other) =
+      default;
+    constexpr strict_not_null &operator=(strict_not_null &&other) = default;
+
+    constexpr ~strict_not_null() = default;
+
+    template<typename U,
+      typename = std::enable_if_t<std::is_convertible<U, T>::value>>
+    constexpr strict_not_null &operator=(strict_not_null<U> const &other)
+    {
+      this->ptr_ = other.ptr_;
+      return *this;
+    }
+
+    template<typename U,
+      typename = std::enable_if_t<std::is_convertible<U, T>::value>>
+    constexpr strict_not_null &operator=(strict_not_null<U> &&other)
+    {
+      this->ptr_ = std::move(other.ptr_);
+      return *this;
+    }
+
+    // Stores u in place, for a self relative T, e.g. a member of a node on
+    // the heap, where a strict_not_null built first on the stack may be too
+    // far from the target to encode it.  A null u is a null violation,
+    // reported at the caller.
+    template<typename U>
+      requires details::IsSelfRelative<T> && std::is_convertible_v<U, T>
+    constexpr void reset(U const &u,
+      std::source_location const &location =
+        std::source_location::current())
+    {
+      details::check_not_null(
+        u, "strict_not_null from a null pointer", location);
+      this->ptr_ = u;
+    }
+
+
+  public:
+    // The pointer, known by the optimizer not to be null, so that a test of
+    // the result is folded away.
+    constexpr details::value_or_reference_return_t<T> get() const
+    {
+      assume_invariant();
+      return this->ptr_;
+    }
+
+    constexpr decltype(auto) operator->() const { return this->get(); }
+    constexpr decltype(auto) operator*() const { return *(this->get()); }
+
+
+  private:
+    // Not with MP_NULL_POLICY_OBSERVE, which carries on with a null pointer.
+    constexpr void assume_invariant() const noexcept
+    {
+      if constexpr (details::RawPointer<T>
+                    && details::active_null_policy != null_policy::observe) {
+        MP_ASSUME(this->ptr_ != nullptr);
+      }
+    }
+
+    // The disengaged state of optional_not_null, never handed out.
+    struct disengaged_t
+    {
+      explicit disengaged_t() = default;
+    };
+
+    constexpr explicit strict_not_null(disengaged_t) noexcept
+      : wrapped_pointer<T>(nullptr)
+    {}
+
+    template<details::Pointer U> friend class maybe_null;
+    template<details::RawPointer U> friend class optional_not_null;
+  };
+
+
+  // A strict_not_null made at compile time from a constant address, e.g.
+  // &global, so that there is nothing left to test at run time.  A null
+  // pointer does not compile.
+  template<typename T>
+  [[nodiscard]] consteval strict_not_null<T *> constant_not_null(T *ptr)
+  {
+    if (ptr == nullptr) {
+      details::fatal_null_violation(
+        "constant_not_null of a null pointer", std::source_location::current());
+    }
+    return strict_not_null<T *>(assume_not_null, ptr);
+  }
+
+
+#if (defined(__cpp_deduction_guides) && (__cpp_deduction_guides >= 201611L))
+
+  // deduction guides to prevent the ctad-maybe-unsupported warning
+  template<class T> strict_not_null(T) -> strict_not_null<T>;
+
+#endif// ( defined(__cpp_deduction_guides) && (__cpp_deduction_guides >=
+      // 201611L) )
+
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  // optional_not_null
+  //
+  // std::optional<strict_not_null<T>> for a raw pointer T, with null as the
+  // disengaged state instead of a flag, so that it has the size of T, is
+  // trivially copyable and is returned in a register:
+  //
+  //   optional_not_null<Node *> find(Key key);
+  //
+  //   if (auto node = find(key)) { use(*node); }
+  //
+  // It has the interface of std::optional, and converts to it.  It is what
+  // maybe_null<T>#as_optional_not_null() returns for a raw pointer T.
+  ////////////////////////////////////////////////////////////////////////////
+  template<details::RawPointer T> class optional_not_null
+  {
+  public:
+    using value_type = strict_not_null<T>;
+
+    constexpr optional_not_null() noexcept
+      : value_(typename value_type::disengaged_t{})
+    {}
+
+    constexpr optional_not_null(std::nullopt_t) noexcept : optional_not_null()
+    {}
+
+    constexpr optional_not_null(value_type value) noexcept : value_(value) {}
+
+    template<typename U>
+      requires std::is_convertible_v<U, T>
+    constexpr optional_not_null(strict_not_null<U> const &value) noexcept
+      : value_(assume_not_null, value.ptr_)
+    {}
+
+    template<typename U>
+      requires std::is_convertible_v<U, T>
+    constexpr optional_not_null(optional_not_null<U> const &other) noexcept
+      : optional_not_null()
+    {
+      if (other.has_value()) {
+        value_ = value_type(assume_not_null, other->ptr_);
+      }
+    }
+
+    constexpr optional_not_null(
+      std::optional<value_type> const &other) noexcept
+      : optional_not_null()
+    {
+      if (other.has_value()) { value_ = *other; }
+    }
+
+    constexpr optional_not_null &operator=(std::nullopt_t) noexcept
+    {
+      reset();
+      return *this;
+    }
+
+    constexpr optional_not_null &operator=(value_type value) noexcept
+    {
+      value_ = value;
+      return *this;
+    }
+
+    [[nodiscard]] constexpr bool has_value() const noexcept
+    {
+      return value_.ptr_ != nullptr;
+    }
+
+    constexpr explicit operator bool() const noexcept { return has_value(); }
+
+    // Undefined behaviour when disengaged, as for std::optional.
+    constexpr value_type const *operator->() const noexcept { return &value_; }
+    constexpr value_type *operator->() noexcept { return &value_; }
+    constexpr value_type const &operator*() const noexcept { return value_; }
+    constexpr value_type &operator*() noexcept { return value_; }
+
+    // Throws std::bad_optional_access when disengaged.
+    constexpr value_type const &value() const
+    {
+      if (!has_value()) {
+        details::raise<std::bad_optional_access>("optional_not_null is empty");
+      }
+      return value_;
+    }
+
+    constexpr value_type &value()
+    {
+      if (!has_value()) {
+        details::raise<std::bad_optional_access>("optional_not_null is empty");
+      }
+      return value_;
+    }
+
+    template<typename U>
+    [[nodiscard]] constexpr value_type value_or(U &&other) const
+    {
+      return has_value() ? value_ : value_type(std::forward<U>(other));
+    }
+
+    // A null pointer is a null violation, as for the strict_not_null
+    // constructor.
+    template<typename... Args> constexpr value_type &emplace(Args &&...args)
+    {
+      value_ = value_type(std::forward<Args>(args)...);
+      return value_;
+    }
+
+    constexpr void reset() noexcept
+    {
+      value_ = value_type(typename value_type::disengaged_t{});
+    }
+
+    constexpr void swap(optional_not_null &other) noexcept
+    {
+      std::swap(value_, other.value_);
+    }
+
+    constexpr operator std::optional<value_type>() const noexcept
+    {
+      if (!has_value()) { return std::nullopt; }
+      return value_;
+    }
+
+    friend constexpr bool operator==(optional_not_null const &lhs,
+      optional_not_null const &rhs) noexcept
+    {
+      return lhs.value_.ptr_ == rhs.value_.ptr_;
+    }
+
+    friend constexpr bool operator==(optional_not_null const &lhs,
+      std::nullopt_t) noexcept
+    {
+      return !lhs.has_value();
+    }
+
+    friend constexpr bool operator==(optional_not_null const &lhs,
+      value_type const &rhs) noexcept
+    {
+      return lhs.value_.ptr_ == rhs.ptr_;
+    }
+
+  private:
+    value_type value_;
+  };
+
+  template<typename T>
+  optional_not_null(strict_not_null<T>) -> optional_not_null<T>;
+
+  MP_END_EXPORT
+
+  namespace details {
+    template<typename T> struct optional_not_null_of
+    {
+      using type = std::optional<strict_not_null<T>>;
+    };
+
+    template<RawPointer T> struct optional_not_null_of<T>
+    {
+      using type = optional_not_null<T>;
+    };
+  }// namespace details
+
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  // variant_not_null
+  //
+  // std::variant<std::nullptr_t, strict_not_null<T>> for a raw pointer T,
+  // where the pointer is its own index, so that it has the size of T and a
+  // visit is a single test rather than the dispatch of std::visit:
+  //
+  //   variant_not_null<Node *> next = node.as_variant_not_null();
+  //   visit(overloaded{ [](std::nullptr_t) { ... },
+  //           [](strict_not_null<Node *> n) { ... } },
+  //     next);
+  //
+  // index(), holds_alternative, get, get_if and visit work as for
+  // std::variant, found by ADL or qualified with marcpawl::pointers.  It
+  // converts to and from the std::variant.  It is what
+  // maybe_null<T>#as_variant_not_null() returns for a raw pointer T.
+  ////////////////////////////////////////////////////////////////////////////
+  namespace details {
+    inline constexpr std::nullptr_t null_alternative = nullptr;
+
+    struct variant_access
+    {
+      template<typename V> static constexpr auto &value(V &variant) noexcept
+      {
+        return variant.value_;
+      }
+    };
+  }// namespace details
+
+  MP_BEGIN_EXPORT
+
+  template<details::RawPointer T> class variant_not_null
+  {
+  public:
+    using not_null_type = strict_not_null<T>;
+    using std_variant = std::variant<std::nullptr_t, not_null_type>;
+
+    // Holds nullptr, the first alternative, as std::variant does.
+    constexpr variant_not_null() noexcept = default;
+    constexpr variant_not_null(std::nullptr_t) noexcept {}
+    constexpr variant_not_null(not_null_type value) noexcept : value_(value) {}
+
+    template<typename U>
+      requires std::is_convertible_v<U, T>
+    constexpr variant_not_null(variant_not_null<U> const &other) noexcept
+      : value_(details::variant_access::value(other))
+    {}
+
+    constexpr variant_not_null(std_variant const &other) noexcept
+    {
+      if (auto const *value = std::get_if<1>(&other)) { value_ = *value; }
+    }
+
+    constexpr operator std_variant() const noexcept
+    {
+      if (value_.has_value()) { return *value_; }
+      return nullptr;
+    }
+
+    [[nodiscard]] constexpr std::size_t index() const noexcept
+    {
+      return value_.has_value() ? 1 : 0;
+    }
+
+    [[nodiscard]] constexpr bool valueless_by_exception() const noexcept
+    {
+      return false;
+    }
+
+    // visitor(nullptr) or visitor(strict_not_null<T>), which must return
+    // the same type.
+    template<typename Visitor>
+    constexpr decltype(auto) visit(Visitor &&visitor) const
+    {
+      if (value_.has_value()) {
+        return std::forward<Visitor>(visitor)(*value_);
+      } else {
+        return std::forward<Visitor>(visitor)(details::null_alternative);
+      }
+    }
+
+    constexpr void swap(variant_not_null &other) noexcept
+    {
+      value_.swap(other.value_);
+    }
+
+    friend constexpr bool operator==(variant_not_null const &lhs,
+      variant_not_null const &rhs) noexcept
+    {
+      return lhs.value_ == rhs.value_;
+    }
+
+  private:
+    friend struct details::variant_access;
+
+    optional_not_null<T> value_;
+  };
+
+  template<typename T>
+  variant_not_null(strict_not_null<T>) -> variant_not_null<T>;
+
+  template<typename Alternative, typename T>
+  [[nodiscard]] constexpr bool holds_alternative(
+    variant_not_null<T> const &variant) noexcept
+  {
+    static_assert(std::is_same_v<Alternative, std::nullptr_t>
+                    || std::is_same_v<Alternative, strict_not_null<T>>,
+      "holds_alternative: not an alternative of variant_not_null");
+    return variant.index()
+           == (std::is_same_v<Alternative, std::nullptr_t> ? 0U : 1U);
+  }
+
+  template<std::size_t I, typename T>
+  [[nodiscard]] constexpr auto const *get_if(
+    variant_not_null<T> const *variant) noexcept
+  {
+    static_assert(I < 2, "get_if: variant_not_null has 2 alternatives");
+    if constexpr (I == 0) {
+      return variant != nullptr && variant->index() == 0
+               ? &details::null_alternative
+               : nullptr;
+    } else {
+      return variant != nullptr && variant->index() == 1
+               ? &*details::variant_access::value(*variant)
+               : nullptr;
+    }
+  }
+
+  template<typename Alternative, typename T>
+  [[nodiscard]] constexpr auto const *get_if(
+    variant_not_null<T> const *variant) noexcept
+  {
+    return get_if<std::is_same_v<Alternative, std::nullptr_t> ? 0U : 1U>(
+      variant);
+  }
+
+  // Throws std::bad_variant_access for the other alternative.
+  template<std::size_t I, typename T>
+  [[nodiscard]] constexpr auto const &get(variant_not_null<T> const &variant)
+  {
+    auto const *const value = get_if<I>(&variant);
+    if (value == nullptr) {
+      details::raise<std::bad_variant_access>("variant_not_null");
+    }
+    return *value;
+  }
+
+  template<typename Alternative, typename T>
+  [[nodiscard]] constexpr auto const &get(variant_not_null<T> const &variant)
+  {
+    static_assert(std::is_same_v<Alternative, std::nullptr_t>
+                    || std::is_same_v<Alternative, strict_not_null<T>>,
+      "get: not an alternative of variant_not_null");
+    return get<std::is_same_v<Alternative, std::nullptr_t> ? 0U : 1U>(
+      variant);
+  }
+
+  template<typename Visitor, typename T>
+  constexpr decltype(auto) visit(Visitor &&visitor,
+    variant_not_null<T> const &variant)
+  {
+    return variant.visit(std::forward<Visitor>(visitor));
+  }
+
+  MP_END_EXPORT
+
+  namespace details {
+    template<typename T> struct variant_not_null_of
+    {
+      using type = std::variant<std::nullptr_t, strict_not_null<T>>;
+    };
+
+    template<RawPointer T> struct variant_not_null_of<T>
+    {
+      using type = variant_not_null<T>;
+    };
+  }// namespace details
+
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  // maybe_null
+  //
+  // Holds a pointer, but has not pointer operations.  To get the pointer
+  // use maybe_null#as_non_null()
+  //
+  // Has zero size overhead over T.
+  //
+  // If T is a pointer (i.e. T == U*) then
+  // - allow construction from U*
+  // - disallow construction from nullptr_t
+  // - disallow default construction
+  // - ensure construction from null U* fails
+  // - allow implicit conversion to U*
+  //
+  // Navigation through nullable links is a chain, with one exit for null
+  // at the end rather than a visit per link:
+  //
+  //   int zip = maybe_null(order)
+  //               .then(&Order::customer)
+  //               .then(&Customer::address)
+  //               .transform([](auto a) { return a->zip; })
+  //               .value_or(0);
+  //
+  // then(f) gives maybe_null of the pointer f returns, f being a member
+  // pointer or a callable of the pointee; and_then, transform and or_else
+  // are those of std::optional.  Each step is a test and a load, inlined,
+  // with nothing built in between.
+  //
+  ////////////////////////////////////////////////////////////////////////////
+  namespace details {
+    template<typename M> struct member_class;
+    template<typename M, typename C> struct member_class<M C::*>
+    {
+      using type = C;
+    };
+
+    // object.*f, or (*object).*f when object is a pointer or a wrapper.
+    template<typename F, typename Object, typename... Args>
+    constexpr decltype(auto) invoke_member(F f,
+      Object &&object,
+      Args &&...args)
+    {
+      using type = typename member_class<F>::type;
+      if constexpr (!std::is_base_of_v<type, std::remove_cvref_t<Object>>) {
+        return invoke_member(
+          f, *std::forward<Object>(object), std::forward<Args>(args)...);
+      } else if constexpr (std::is_member_function_pointer_v<F>) {
+        return (std::forward<Object>(object).*f)(std::forward<Args>(args)...);
+      } else {
+        return (std::forward<Object>(object).*f);
+      }
+    }
+
+    // std::invoke, without the cost of <functional>.
+    template<typename F, typename... Args>
+    constexpr decltype(auto) invoke(F &&f, Args &&...args)
+    {
+      if constexpr (std::is_member_pointer_v<std::remove_cvref_t<F>>) {
+        return invoke_member(f, std::forward<Args>(args)...);
+      } else {
+        return std::forward<F>(f)(std::forward<Args>(args)...);
+      }
+    }
+  }// namespace details
+
+  MP_BEGIN_EXPORT
+
+  template<details::Pointer T> class maybe_null : public wrapped_pointer<T>
+  {
+  public:
+    // T, or the raw pointer a self relative T decodes to, see
+    // details::not_null_pointer.
+    using not_null_pointer = details::not_null_pointer_t<T>;
+    // pointers::optional_not_null for a raw pointer, the same size as T.
+    using optional_not_null =
+      typename details::optional_not_null_of<not_null_pointer>::type;
+    // pointers::variant_not_null for a raw pointer, the same size as T.
+    using variant_not_null =
+      typename details::variant_not_null_of<not_null_pointer>::type;
+
+    constexpr maybe_null() noexcept : wrapped_pointer<T>(nullptr) {}
+
+    constexpr explicit maybe_null(std::nullptr_t) noexcept
+      : wrapped_pointer<T>(nullptr)
+    {}
+
+
+    /** Construct from a pointer. */
+    template<typename U,
+      typename = std::enable_if_t<std::is_convertible<U, T>::value>>
+    explicit constexpr maybe_null(U const &u)
+      requires std::is_copy_constructible_v<T>
+      : wrapped_pointer<T>(std::in_place, u)
+    {}
+
+    /** Construct from a pointer. */
+    explicit constexpr maybe_null(T &&t)
+      requires std::is_move_constructible_v<T>
+      : wrapped_pointer<T>(std::move(t))
+    {}
+
+    /** Copy constructor */
+    constexpr maybe_null(maybe_null<T> const &other) noexcept(
+      std::is_nothrow_move_constructible<T>::value) = default;
+
+    /** Copy constructor */
+    template<typename U,
+      typename = std::enable_if_t<std::is_convertible<U, T>::value>>
+    constexpr maybe_null(maybe_null<U> const &other) noexcept(
+      std::is_nothrow_move_constructible<T>::value)
+      : maybe_null(other.ptr_)
+    {}
+
+    /** Move constructor */
+    constexpr maybe_null(maybe_null<T> &&other) noexcept(
+      std::is_nothrow_move_constructible<T>::value) = default;
+
+    /** Move constructor */
+    template<typename U,
+      typename = std::enable_if_t<std::is_convertible<U, T>::value>>
+    constexpr maybe_null(maybe_null<U> &&other) noexcept(
+      std::is_nothrow_move_constructible<T>::value)
+      : maybe_null(std::move(other.ptr_))
+    {}
+
+    ~maybe_null() = default;
+
+    constexpr maybe_null &operator=(maybe_null const &other) = default;
+    constexpr maybe_null &operator=(maybe_null &&other) = default;
+
+    // Stores u in place.  For a self relative T, e.g. a member of a node on
+    // the heap, a maybe_null built first on the stack may be too far from
+    // the target to encode it.  Other T are only built explicitly.
+    template<typename U>
+      requires details::IsSelfRelative<T> && std::is_convertible_v<U, T>
+    constexpr maybe_null &operator=(U const &u)
+    {
+      this->ptr_ = u;
+      return *this;
+    }
+
+    template<typename U>
+      requires details::IsSelfRelative<T> && std::is_convertible_v<U, T>
+    constexpr maybe_null &operator=(maybe_null<U> const &other)
+    {
+      this->ptr_ = other.ptr_;
+      return *this;
+    }
+
+    // Likelihood weights the test for null, see null_likelihood.  The
+    // location of the caller is only kept by the call site counters, see
+    // call_sites.hpp.
+    template<null_likelihood Likelihood = null_likelihood::unknown>
+    [[nodiscard]] constexpr optional_not_null as_optional_not_null(
+      std::source_location const &location =
+        std::source_location::current()) const &
+    {
+      details::count_call_site(details::call_site_event::call, location);
+      if (details::expect_null<Likelihood>(this->ptr_ == nullptr)) {
+        details::count_call_site(
+          details::call_site_event::null_branch, location);
+        return std::nullopt;
+      } else {
+        return optional_not_null{ not_null() };
+      }
+    }
+
+    template<null_likelihood Likelihood = null_likelihood::unknown>
+    [[nodiscard]] constexpr optional_not_null as_optional_not_null(
+      std::source_location const &location =
+        std::source_location::current()) &&
+    {
+      details::count_call_site(details::call_site_event::call, location);
+      if (details::expect_null<Likelihood>(this->ptr_ == nullptr)) {
+        details::count_call_site(
+          details::call_site_event::null_branch, location);
+        return std::nullopt;
+      } else {
+        if constexpr (details::IsSelfRelative<T>) {
+          return optional_not_null{ not_null() };
+        } else {
+          strict_not_null<T> ptr{ assume_not_null, std::move(this->ptr_) };
+          return optional_not_null{ std::move(ptr) };
+        }
+      }
+    }
+
+    template<null_likelihood Likelihood = null_likelihood::unknown>
+    [[nodiscard]] constexpr variant_not_null as_variant_not_null(
+      std::source_location const &location =
+        std::source_location::current()) const
+    {
+      details::count_call_site(details::call_site_event::call, location);
+      if (details::expect_null<Likelihood>(this->ptr_ == nullptr)) {
+        details::count_call_site(
+          details::call_site_event::null_branch, location);
+        return nullptr;
+      } else {
+        return not_null();
+      }
+    }
+
+    // The handler of the unlikely branch is called out of line.
+    template<null_likelihood Likelihood = null_likelihood::unknown>
+    [[nodiscard]] constexpr auto visit(nullptr_handler auto handle_nullptr,
+      not_null_handler<T> auto handle_not_null,
+      std::source_location const &location =
+        std::source_location::current()) const
+    {
+      details::count_call_site(details::call_site_event::call, location);
+      if (details::expect_null<Likelihood>(this->ptr_ == nullptr)) {
+        details::count_call_site(
+          details::call_site_event::null_branch, location);
+        return details::call_handler<Likelihood == likely_not_null>(
+          handle_nullptr, nullptr);
+      } else {
+        return details::call_handler<Likelihood == likely_null>(
+          handle_not_null, not_null());
+      }
+    }
+
+    // maybe_null of the pointer that f, a member pointer or a callable,
+    // gives for the pointee, e.g. then(&Node::next); null when this is.
+    template<typename F> [[nodiscard]] constexpr auto then(F &&f) const
+    {
+      using result = decltype(details::raw_pointer_of(
+        details::invoke(std::forward<F>(f), *this->ptr_)));
+      if (this->ptr_ == nullptr) { return maybe_null<result>(); }
+      return maybe_null<result>(details::raw_pointer_of(
+        details::invoke(std::forward<F>(f), *this->ptr_)));
+    }
+
+    // f(strict_not_null<T>), which returns a maybe_null or an optional, or
+    // an empty one of the same type when this is null.
+    template<typename F> [[nodiscard]] constexpr auto and_then(F &&f) const
+    {
+      using result = std::remove_cvref_t<
+        std::invoke_result_t<F, strict_not_null<not_null_pointer>>>;
+      if (this->ptr_ == nullptr) { return result(); }
+      return details::invoke(std::forward<F>(f), not_null());
+    }
+
+    // std::optional of f(strict_not_null<T>), empty when this is null.
+    template<typename F> [[nodiscard]] constexpr auto transform(F &&f) const
+    {
+      using result = std::remove_cvref_t<
+        std::invoke_result_t<F, strict_not_null<not_null_pointer>>>;
+      if (this->ptr_ == nullptr) { return std::optional<result>(); }
+      return std::optional<result>(
+        details::invoke(std::forward<F>(f), not_null()));
+    }
+
+    // This, or f() when this is null.
+    template<typename F> [[nodiscard]] constexpr maybe_null or_else(F &&f) const
+    {
+      if (this->ptr_ == nullptr) { return details::invoke(std::forward<F>(f)); }
+      return *this;
+    }
+
+    [[nodiscard]] constexpr strict_not_null<not_null_pointer> value_or(
+      strict_not_null<not_null_pointer> fallback) const
+    {
+      if (this->ptr_ == nullptr) { return fallback; }
+      return not_null();
+    }
+
+    [[deprecated]] [[nodiscard]] constexpr details::value_or_reference_return_t<
+      T>
+      get() const noexcept(noexcept(
+        details::value_or_reference_return_t<T>{ std::declval<T &>() }))
+    {
+      return this->ptr_;
+    }
+
+    [[deprecated]]
+    constexpr decltype(auto) operator->() const noexcept(false)
+    {
+      details::check_not_null(this->ptr_,
+        "maybe_null dereferenced while null",
+        std::source_location::current());
+      return get();
+    }
+
+    [[deprecated]]
+    constexpr decltype(auto) operator*() const
+    {
+      details::check_not_null(this->ptr_,
+        "maybe_null dereferenced while null",
+        std::source_location::current());
+      return *get();
+    }
+
+    template<details::Pointer U> friend class maybe_null;
+
+  private:
+    // This pointer, which is not null, as it is handed out.
+    constexpr strict_not_null<not_null_pointer> not_null() const
+    {
+      if constexpr (details::IsSelfRelative<T>) {
+        return strict_not_null<not_null_pointer>{
+          assume_not_null, this->ptr_.get()
+        };
+      } else {
+        return strict_not_null<T>{ assume_not_null, this->ptr_ };
+      }
+    }
+  };
+
+
+  template<class T> [[nodiscard]] constexpr auto make_maybe_null(T &&t) noexcept
+  {
+    return maybe_null<std::remove_cv_t<std::remove_reference_t<T>>>{
+      std::forward<T>(t)
+    };
+  }
+
+
+#if (defined(__cpp_deduction_guides) && (__cpp_deduction_guides >= 201611L))
+
+  // deduction guides to prevent the ctad-maybe-unsupported warning
+  template<class T> maybe_null(T) -> maybe_null<T>;
+
+#endif// ( defined(__cpp_deduction_guides) && (__cpp_deduction_guides >=
+      // 201611L) )
+
+  //////////////////////////////////////////////
+  //
+  // borrower
+  //
+  // Restricts the pointer to not be deleted.
+  //
+  // Has zero size overhead over T.
+  //
+  // If T is a pointer (i.e. T == U*) then
+  // - allow construction from U*
+  // - allow implicit conversion to U*
+  //
+  // based on gsl::not_null
+  ////////////////////////////////////////////////////////////////////////////
+
+  template<details::Pointer T> class borrower : public wrapped_pointer<T>
+  {
+  public:
+    constexpr explicit borrower()
+      requires std::is_default_constructible_v<T>
+    {}
+
+    constexpr explicit borrower(std::nullptr_t) noexcept
+      requires(Nullable<T>)
+      : wrapped_pointer<T>(nullptr)
+    {}
+
+    template<details::IsUnManagedPtr U,
+      typename = std::enable_if_t<std::is_convertible<U, T>::value>>
+    constexpr explicit borrower(U ptr) : wrapped_pointer<T>(std::in_place, ptr)
+    {
+      stamp();
+    }
+
+    template<details::IsUniquePtr U,
+      typename =
+        std::enable_if_t<std::is_convertible<typename U::pointer, T>::value>>
+    constexpr explicit borrower(U const &ptr) : wrapped_pointer<T>(ptr.get())
+    {
+      stamp();
+    }
+
+    template<details::IsSharedPtr U,
+      typename = std::enable_if_t<
+        std::is_convertible<typename U::element_type *, T>::value>>
+    constexpr explicit borrower(U const &ptr) : wrapped_pointer<T>(ptr.get())
+    {
+      stamp();
+    }
+
+    // Leaves the reference count alone.
+    template<details::IsIntrusivePtr U,
+      typename = std::enable_if_t<
+        std::is_convertible<typename U::element_type *, T>::value>>
+    constexpr explicit borrower(U const &ptr) noexcept
+      : wrapped_pointer<T>(ptr.get())
+    {
+      stamp();
+    }
+
+    template<typename U,
+      typename = std::enable_if_t<std::is_convertible<U, T>::value>>
+    constexpr borrower(borrower<U> const &other) noexcept
+      : wrapped_pointer<T>(other.get())
+    {
+#if defined(MP_BORROW_CHECKS)
+      stamp_ = other.stamp_;
+#endif
+    }
+
+    template<typename U,
+      typename = std::enable_if_t<std::is_convertible<U, T>::value>>
+    constexpr explicit borrower(borrower<U> &&other) noexcept
+      : wrapped_pointer<T>(other.get())
+    {
+#if defined(MP_BORROW_CHECKS)
+      stamp_ = other.stamp_;
+#endif
+      static_assert(
+        std::is_rvalue_reference<decltype(other)>::value, "Must be an rvalue");
+      // Owner cannot move pointer to borrower.
+      // Borrower cannot move pointer to owner.
+    }
+
+    template<details::Pointer U>
+    constexpr explicit borrower(owner<U> const &other)
+      requires(std::is_convertible<U, T>::value);
+
+    ~borrower() = default;
+
+    template<typename U,
+      typename = std::enable_if_t<std::is_convertible<U, T>::value>>
+    constexpr borrower<T> &operator=(borrower<U> const &other) noexcept
+    {
+      // TODO borrower accepts owner
+      if (this == other) { return *this; }
+      this->ptr_ = other.get();
+#if defined(MP_BORROW_CHECKS)
+      stamp_ = other.stamp_;
+#endif
+      return *this;
+    }
+
+    // Stores u in place, as maybe_null does, for a self relative T that a
+    // borrower built first on the stack may be too far to encode.
+    template<typename U>
+      requires details::IsSelfRelative<T> && std::is_convertible_v<U, T>
+    constexpr borrower &operator=(U const &u)
+    {
+      this->ptr_ = u;
+      stamp();
+      return *this;
+    }
+
+    /** No operator to prevent the pointer escaping, and a constructor
+     * called with the pointer.
+     */
+    //    operator T() const = delete;
+
+    constexpr decltype(auto) operator->() const
+    {
+      check_alive();
+      return this->get();
+    }
+    constexpr decltype(auto) operator*() const
+    {
+      check_alive();
+      return *(this->get());
+    }
+#ifdef TODO
+    constexpr operator bool() const { return this->get() != nullptr; }
+#endif
+
+
+    template<details::Pointer U>
+    friend constexpr borrower<U> make_borrower(U ptr);
+    template<details::Pointer U> friend class borrower;
+#if defined(MP_BORROW_CHECKS)
+    friend struct details::borrow_access;
+#endif
+
+  private:
+    // See MP_BORROW_CHECKS.  Only a borrower made from a pointer looks its
+    // object up, one made from an owner or a borrower copies its stamp.
+    constexpr void stamp() noexcept
+    {
+#if defined(MP_BORROW_CHECKS)
+      stamp_ = details::borrow_stamp(this->ptr_);
+#endif
+    }
+
+    constexpr void check_alive() const
+    {
+#if defined(MP_BORROW_CHECKS)
+      if (!std::is_constant_evaluated()
+          && !details::borrow_table::alive(stamp_)) [[unlikely]] {
+        details::dangling_borrower(std::source_location::current());
+      }
+#endif
+    }
+
+#if defined(MP_BORROW_CHECKS)
+    // The object when it was borrowed, not tracked by default.
+    details::borrow_table::stamp_type stamp_{};
+#endif
+  };
+
+  // deduction guides to prevent the ctad-maybe-unsupported warning
+  template<class T> borrower(T) -> borrower<T>;
+
+  template<details::IsUnManagedPtr U> constexpr auto make_borrower(U ptr)
+  {
+    return borrower<U>{ ptr };
+  }
+
+  template<typename T>
+  [[nodiscard]] constexpr auto make_borrower(owner<T> const &theOwner)
+    -> borrower<T>
+  {
+    return theOwner.as_borrower();
+  }
+
+  template<details::IsUniquePtr U>
+  constexpr auto make_borrower(U const &ptr) -> borrower<typename U::pointer>
+  {
+    return make_borrower(ptr.get());
+  }
+
+  template<details::IsSharedPtr U>
+  constexpr auto make_borrower(U const &ptr)
+    -> borrower<typename U::element_type *>
+  {
+    return make_borrower(ptr.get());
+  }
+
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  // owner
+  //
+  // Indicates that the pointer resource should be removed.
+  // Should be migrated to std::unique_ptr, std::shared_ptr, or
+  // std::weak_ptr.  Provided as a step in transforming a legacy
+  // program.
+  //
+  // Has zero size overhead over T.
+  //
+  // If T is a pointer (i.e. T == U*) then
+  // - allow construction from U*
+  // - allow implicit conversion to U*
+  //
+  // based on gsl::not_null
+  ////////////////////////////////////////////////////////////////////////////
+
+
+  template<details::Pointer T> class owner : public wrapped_pointer<T>
+  {
+  public:
+    constexpr explicit owner()
+      requires std::is_default_constructible_v<T>
+    {
+      ;
+    }
+
+    constexpr explicit owner(std::nullptr_t) noexcept
+      requires(Nullable<T>)
+      : wrapped_pointer<T>(nullptr)
+    {}
+
+    constexpr explicit owner(T ptr) : wrapped_pointer<T>(ptr)
+    {
+#if defined(MP_BORROW_CHECKS)
+      if (!std::is_constant_evaluated()) {
+        stamp_ =
+          details::borrow_table::begin(details::raw_pointer_of(this->ptr_));
+      }
+#endif
+    }
+
+    template<typename U,
+      typename = std::enable_if_t<std::is_convertible<U, T>::value>>
+    constexpr explicit owner(owner<U> &&other)
+      : wrapped_pointer<T>(std::move(other.ptr_))
+    {
+#if defined(MP_BORROW_CHECKS)
+      stamp_ = other.stamp_;
+#endif
+    }
+
+    ~owner() = default;
+
+    template<typename U,
+      typename = std::enable_if_t<std::is_convertible<U, T>::value>>
+    constexpr owner<T> &operator=(owner<U> const &other) noexcept
+    {
+      // TODO borrower accepts owner
+      if (this == other) { return *this; }
+      this->ptr_ = other.get();
+#if defined(MP_BORROW_CHECKS)
+      stamp_ = other.stamp_;
+#endif
+      return *this;
+    }
+
+    constexpr decltype(auto) operator->() const { return this->get(); }
+    constexpr decltype(auto) operator*() const { return *this->get(); }
+#ifdef TODO
+    constexpr operator bool() const { return this->get() != nullptr; }
+#endif
+
+    constexpr borrower<T> as_borrower() const { return borrower<T>(*this); }
+
+    template<details::Pointer U> friend constexpr owner<U> make_owner(U ptr);
+    template<details::Pointer U> friend class owner;
+    template<details::Pointer U> friend class borrower;
+
+#if defined(MP_BORROW_CHECKS)
+    friend struct details::borrow_access;
+
+  private:
+    // The stamp of the object from when it was given to the owner, copied
+    // into its borrowers so that borrowing does not look it up.
+    details::borrow_table::stamp_type stamp_{};
+#endif
+  };
+
+
+  template<details::Pointer T> constexpr owner<T> make_owner(T ptr)
+  {
+    return owner<T>(ptr);
+  }
+
+  // Deletes the object of an owner.  Its borrowers must not be used any
+  // more, see MP_BORROW_CHECKS.
+  template<typename T> constexpr void delete_owned(owner<T *> object) noexcept
+  {
+    end_borrows(object.get());
+    delete object.get();
+  }
+
+  template<details::Pointer T>
+  template<details::Pointer U>
+  constexpr borrower<T>::borrower(owner<U> const &theOwner)
+    requires(std::is_convertible<U, T>::value)
+    : wrapped_pointer<T>(theOwner.ptr_)
+  {
+#if defined(MP_BORROW_CHECKS)
+    stamp_ = theOwner.stamp_;
+#endif
+  }
+
+#if defined(MP_BORROW_CHECKS)
+
+  MP_END_EXPORT
+
+  namespace details {
+    struct borrow_access
+    {
+      template<typename W>
+      static constexpr borrow_table::stamp_type stamp(W const &w) noexcept
+      {
+        return w.stamp_;
+      }
+
+      // A W holding ptr with the given stamp, without looking the object
+      // up nor, for an owner, starting its lifetime again.
+      template<typename W>
+      static constexpr W make(decltype(W::ptr_) ptr,
+        borrow_table::stamp_type stamp) noexcept
+      {
+        W w;
+        w.ptr_ = ptr;
+        w.stamp_ = stamp;
+        return w;
+      }
+    };
+  }// namespace details
+
+  MP_BEGIN_EXPORT
+
+#endif
+
+  template<class T, std::enable_if_t<std::is_pointer<T>::value, bool> = true>
+  using nonowner = T;
+
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  // Hashing
+  //
+  // std::hash of a wrapper is std::hash of the pointer it holds.
+  //
+  // pointer_hash and pointer_equal are transparent, a container keyed by one
+  // wrapper can be searched with a raw pointer, a smart pointer or any other
+  // wrapper without building a temporary key:
+  //
+  //   std::unordered_set<borrower<Node *>, pointer_hash, pointer_equal> s;
+  //   s.find(raw);// Node *
+  //   s.find(not_null);// strict_not_null<Node *>
+  //
+  // Both work on the address held, so the keys must point to the same type,
+  // ignoring cv-qualifiers.
+  ////////////////////////////////////////////////////////////////////////////
+
+  MP_END_EXPORT
+
+  namespace details {
+    template<typename T>
+    std::true_type is_wrapped_pointer_test(wrapped_pointer<T> const *);
+    std::false_type is_wrapped_pointer_test(...);
+
+    // wrapped_pointer or a class derived from it.
+    template<typename W>
+    concept WrappedPointer =
+      decltype(is_wrapped_pointer_test(std::declval<W const *>()))::value;
+
+    // A wrapper around a raw pointer, e.g. borrower<T *>.
+    template<typename W>
+    concept WrappedRawPointer =
+      WrappedPointer<W> && RawPointer<decltype(W::ptr_)>;
+
+    template<typename W> struct is_strict_not_null : std::false_type
+    {
+    };
+
+    template<typename T>
+    struct is_strict_not_null<strict_not_null<T>> : std::true_type
+    {
+    };
+
+    // Wrappers that carry a stamp, see MP_BORROW_CHECKS.
+    template<typename W> struct is_borrow_checked : std::false_type
+    {
+    };
+
+    template<typename T>
+    struct is_borrow_checked<borrower<T>>
+      : std::bool_constant<borrow_checks>
+    {
+    };
+
+    template<typename T>
+    struct is_borrow_checked<owner<T>> : std::bool_constant<borrow_checks>
+    {
+    };
+
+    template<typename T> struct wrapped_pointer_hash
+    {
+      std::size_t operator()(wrapped_pointer<T> const &p) const
+        noexcept(noexcept(std::hash<T>{}(p.ptr_)))
+      {
+        return std::hash<T>{}(p.ptr_);
+      }
+    };
+  }// namespace details
+
+  MP_BEGIN_EXPORT
+
+  struct pointer_hash
+  {
+    using is_transparent = void;
+
+    template<typename P> std::size_t operator()(P const &p) const noexcept
+    {
+      void const volatile *const address = details::raw_pointer_of(p);
+      return std::hash<void const volatile *>{}(address);
+    }
+  };
+
+  struct pointer_equal
+  {
+    using is_transparent = void;
+
+    template<typename P, typename Q>
+    constexpr bool operator()(P const &lhs, Q const &rhs) const noexcept
+    {
+      return details::raw_pointer_of(lhs) == details::raw_pointer_of(rhs);
+    }
+  };
+
+  MP_END_EXPORT
+}// namespace pointers
+}// namespace marcpawl
+
+template<typename T>
+struct std::hash<marcpawl::pointers::maybe_null<T>>
+  : marcpawl::pointers::details::wrapped_pointer_hash<T>
+{
+};
+
+template<typename T>
+struct std::hash<marcpawl::pointers::strict_not_null<T>>
+  : marcpawl::pointers::details::wrapped_pointer_hash<T>
+{
+};
+
+template<typename T>
+struct std::variant_size<marcpawl::pointers::variant_not_null<T>>
+  : std::integral_constant<std::size_t, 2>
+{
+};
+
+template<typename T>
+struct std::variant_alternative<0, marcpawl::pointers::variant_not_null<T>>
+{
+  using type = std::nullptr_t;
+};
+
+template<typename T>
+struct std::variant_alternative<1, marcpawl::pointers::variant_not_null<T>>
+{
+  using type = marcpawl::pointers::strict_not_null<T>;
+};
+
+// The hash of the pointer, of nullptr when disengaged.
+template<typename T>
+struct std::hash<marcpawl::pointers::optional_not_null<T>>
+{
+  std::size_t operator()(
+    marcpawl::pointers::optional_not_null<T> const &p) const noexcept
+  {
+    return std::hash<T>{}(p.has_value() ? p->ptr_ : nullptr);
+  }
+};
+
+template<typename T>
+struct std::hash<marcpawl::pointers::borrower<T>>
+  : marcpawl::pointers::details::wrapped_pointer_hash<T>
+{
+};
+
+template<typename T>
+struct std::hash<marcpawl::pointers::owner<T>>
+  : marcpawl::pointers::details::wrapped_pointer_hash<T>
+{
+};
+
+#if defined(MP_CALL_SITE_COUNTERS) || defined(MP_CALL_SITE_PROBES)
+#include "marcpawl/pointers/call_sites.hpp"
+#endif
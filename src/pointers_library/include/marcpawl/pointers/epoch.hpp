@@ -0,0 +1,400 @@
+#pragma once
+
+#include "marcpawl/pointers/atomic.hpp"
+#include "marcpawl/pointers/core.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace marcpawl {
+namespace pointers {
+  MP_BEGIN_EXPORT
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  // epoch_domain, epoch_guard, epoch_reclaimer
+  //
+  // Epoch-based reclamation, with the semantics of RCU: readers borrow
+  // inside a read-side critical section, an epoch_guard, and writers
+  // publish a new object and retire the old one, which is deleted after a
+  // grace period, once every critical section that may still see it ended:
+  //
+  //   atomic_strict_not_null<Routes *> routes{ ... };
+  //
+  //   // readers
+  //   epoch_guard<> guard;
+  //   borrower<Routes *> table = guard.borrow(routes);
+  //   use(table->next_hop(address));
+  //
+  //   // writer
+  //   epoch_domain<>::publish(routes, owner<Routes *>(new Routes{ ... }));
+  //
+  // Entering and leaving a critical section are a store and a fence on a
+  // record of the thread, with no read-modify-write.  Guards nest.  The
+  // borrowers of a guard must not outlive it.
+  //
+  // The domain has a global epoch.  It advances once every thread within a
+  // critical section entered it in the current epoch.  An object retired in
+  // epoch e is deleted once the epoch reaches e + 2.
+  //
+  // Each thread collects retired objects in batches of batch_size, then
+  // hands a full batch over to the domain and deletes the batches whose
+  // grace period passed.  While an epoch_reclaimer is running, its thread
+  // does the deleting instead.  A partial batch is handed over by reclaim(),
+  // synchronize() and when the thread exits.
+  //
+  // Tag selects an independent domain, with its own epoch and batches.
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename Tag = void> class epoch_domain;
+
+  template<typename Domain = epoch_domain<>> class epoch_guard;
+
+  template<typename Domain = epoch_domain<>> class epoch_reclaimer;
+
+  template<typename Tag> class epoch_domain
+  {
+  public:
+    // Objects retired by a thread before they are handed over.
+    static constexpr std::size_t batch_size = 64;
+
+    epoch_domain() = delete;
+
+    // Deletes object after a grace period.  Null is ignored.
+    template<typename T> static void retire(owner<T *> object)
+    {
+      retire(object.get(), [](void *ptr) {
+        end_borrows(ptr);
+        delete static_cast<T *>(ptr);
+      });
+    }
+
+    // Calls deleter(object) after a grace period.  Null is ignored.
+    static void retire(void *object, void (*deleter)(void *))
+    {
+      if (object == nullptr) { return; }
+      thread_state &local = state();
+      local.retired.push_back({ object, deleter });
+      if (local.retired.size() >= batch_size) {
+        flush(local);
+        if (shared().reclaimers.load(std::memory_order_relaxed) == 0) {
+          collect();
+        }
+      }
+    }
+
+    // Replaces the object of source, a std::atomic<T *>, an
+    // atomic_maybe_null<T *> or an atomic_strict_not_null<T *>, by desired
+    // and retires the previous one.
+    template<typename Source, typename T>
+    static void publish(Source &source, owner<T *> desired)
+    {
+      retire(owner<T *>(details::exchange_pointer(source, desired.get())));
+    }
+
+    // Waits for a grace period, then deletes what can be.  Everything this
+    // thread retired before is deleted.  Never within an epoch_guard.
+    static void synchronize()
+    {
+      flush(state());
+      shared_state &domain = shared();
+      std::uint64_t const target =
+        domain.epoch.load(std::memory_order_seq_cst) + 2;
+      while (domain.epoch.load(std::memory_order_acquire) < target) {
+        if (!try_advance()) { std::this_thread::yield(); }
+      }
+      collect();
+    }
+
+    // Deletes the objects, retired by any thread, whose grace period
+    // passed.
+    static void reclaim()
+    {
+      flush(state());
+      collect();
+    }
+
+    // Objects retired, by any thread, and not deleted yet.
+    [[nodiscard]] static std::size_t pending()
+    {
+      std::size_t count = state().retired.size();
+      shared_state &domain = shared();
+      std::lock_guard<std::mutex> const lock(domain.batches_mutex);
+      for (auto const &b : domain.batches) { count += b.objects.size(); }
+      return count;
+    }
+
+    [[nodiscard]] static std::uint64_t epoch() noexcept
+    {
+      return shared().epoch.load(std::memory_order_acquire);
+    }
+
+  private:
+    friend class epoch_guard<epoch_domain>;
+    friend class epoch_reclaimer<epoch_domain>;
+
+    struct record
+    {
+      // 0 outside of a critical section, 2 * epoch + 1 within.
+      std::atomic<std::uint64_t> state{ 0 };
+      std::atomic<bool> in_use{ false };
+      record *next = nullptr;
+    };
+
+    struct retired_object
+    {
+      void *object;
+      void (*deleter)(void *);
+    };
+
+    struct batch
+    {
+      std::uint64_t epoch;
+      std::vector<retired_object> objects;
+    };
+
+    struct shared_state
+    {
+      std::atomic<std::uint64_t> epoch{ 1 };
+      std::atomic<record *> records{ nullptr };
+      std::atomic<int> reclaimers{ 0 };
+      std::mutex batches_mutex;
+      std::vector<batch> batches;
+
+      // Only once the other threads are done with the domain.
+      ~shared_state()
+      {
+        for (auto const &b : batches) {
+          for (auto const &r : b.objects) { r.deleter(r.object); }
+        }
+        record *r = records.load(std::memory_order_acquire);
+        while (r != nullptr) {
+          record *const next = r->next;
+          delete r;
+          r = next;
+        }
+      }
+    };
+
+    struct thread_state
+    {
+      record *self = nullptr;
+      unsigned nesting = 0;
+      std::vector<retired_object> retired;
+
+      ~thread_state()
+      {
+        if (self != nullptr) {
+          self->in_use.store(false, std::memory_order_release);
+        }
+        flush(*this);
+      }
+    };
+
+    static shared_state &shared() noexcept
+    {
+      static shared_state domain;
+      return domain;
+    }
+
+    static thread_state &state() noexcept
+    {
+      thread_local thread_state local;
+      return local;
+    }
+
+    static record &acquire_record()
+    {
+      shared_state &domain = shared();
+      for (record *r = domain.records.load(std::memory_order_acquire);
+           r != nullptr;
+           r = r->next) {
+        bool expected = false;
+        if (!r->in_use.load(std::memory_order_relaxed)
+            && r->in_use.compare_exchange_strong(
+              expected, true, std::memory_order_acquire)) {
+          return *r;
+        }
+      }
+      auto *const r = new record;
+      r->in_use.store(true, std::memory_order_relaxed);
+      r->next = domain.records.load(std::memory_order_relaxed);
+      while (!domain.records.compare_exchange_weak(
+        r->next, r, std::memory_order_release, std::memory_order_relaxed)) {}
+      return *r;
+    }
+
+    static void enter()
+    {
+      thread_state &local = state();
+      if (local.nesting++ != 0) { return; }
+      if (local.self == nullptr) { local.self = &acquire_record(); }
+      // A stale epoch only delays the next advance.
+      std::uint64_t const current =
+        shared().epoch.load(std::memory_order_relaxed);
+      local.self->state.store(2 * current + 1, std::memory_order_relaxed);
+      // Either the writer sees this record, or the reader sees the
+      // replacement of the object.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    static void exit() noexcept
+    {
+      thread_state &local = state();
+      if (--local.nesting == 0) {
+        local.self->state.store(0, std::memory_order_release);
+      }
+    }
+
+    // True once the epoch advanced, by this thread or another.
+    static bool try_advance()
+    {
+      shared_state &domain = shared();
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      std::uint64_t current = domain.epoch.load(std::memory_order_seq_cst);
+      for (record *r = domain.records.load(std::memory_order_acquire);
+           r != nullptr;
+           r = r->next) {
+        std::uint64_t const s = r->state.load(std::memory_order_seq_cst);
+        if (s != 0 && s != 2 * current + 1) { return false; }
+      }
+      domain.epoch.compare_exchange_strong(
+        current, current + 1, std::memory_order_seq_cst);
+      return true;
+    }
+
+    // Tagged with the epoch after the last retire, which only delays the
+    // batch.
+    static void flush(thread_state &local)
+    {
+      if (local.retired.empty()) { return; }
+      shared_state &domain = shared();
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      std::uint64_t const current =
+        domain.epoch.load(std::memory_order_seq_cst);
+      std::vector<retired_object> objects;
+      objects.reserve(batch_size);
+      objects.swap(local.retired);
+      std::lock_guard<std::mutex> const lock(domain.batches_mutex);
+      domain.batches.push_back({ current, std::move(objects) });
+    }
+
+    static void collect()
+    {
+      try_advance();
+      shared_state &domain = shared();
+      std::uint64_t const current =
+        domain.epoch.load(std::memory_order_acquire);
+      std::vector<batch> ready;
+      {
+        std::lock_guard<std::mutex> const lock(domain.batches_mutex);
+        auto const held = std::partition(domain.batches.begin(),
+          domain.batches.end(),
+          [current](batch const &b) { return b.epoch + 2 > current; });
+        ready.assign(std::make_move_iterator(held),
+          std::make_move_iterator(domain.batches.end()));
+        domain.batches.erase(held, domain.batches.end());
+      }
+      for (auto const &b : ready) {
+        for (auto const &r : b.objects) { r.deleter(r.object); }
+      }
+    }
+  };
+
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  // epoch_guard
+  //
+  // A read-side critical section of Domain, for the lifetime of the guard.
+  // Neither copied nor moved, it belongs to the scope and the thread that
+  // created it.
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename Domain> class epoch_guard
+  {
+  public:
+    epoch_guard() { Domain::enter(); }
+    ~epoch_guard() { Domain::exit(); }
+
+    epoch_guard(epoch_guard const &) = delete;
+    epoch_guard &operator=(epoch_guard const &) = delete;
+
+    // The current object of source, a std::atomic<T *>, an
+    // atomic_maybe_null<T *> or an atomic_strict_not_null<T *>.  Valid as
+    // long as this guard.
+    template<typename Source>
+    [[nodiscard]] auto borrow(Source const &source) const & noexcept
+    {
+      using pointer =
+        decltype(details::load_pointer(source, std::memory_order_acquire));
+      return borrower<pointer>(
+        details::load_pointer(source, std::memory_order_acquire));
+    }
+
+    template<typename Source> void borrow(Source const &source) && = delete;
+  };
+
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  // epoch_reclaimer
+  //
+  // Runs a thread that advances the epoch of Domain and deletes the retired
+  // batches every interval, so that retire() never deletes.  Stops when
+  // destroyed.
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename Domain> class epoch_reclaimer
+  {
+  public:
+    explicit epoch_reclaimer(
+      std::chrono::milliseconds interval = std::chrono::milliseconds(1))
+      : interval_(interval)
+    {
+      Domain::shared().reclaimers.fetch_add(1, std::memory_order_relaxed);
+      thread_ = std::thread([this] { run(); });
+    }
+
+    epoch_reclaimer(epoch_reclaimer const &) = delete;
+    epoch_reclaimer &operator=(epoch_reclaimer const &) = delete;
+
+    ~epoch_reclaimer()
+    {
+      {
+        std::lock_guard<std::mutex> const lock(mutex_);
+        stop_ = true;
+      }
+      wake_.notify_one();
+      thread_.join();
+      Domain::shared().reclaimers.fetch_sub(1, std::memory_order_relaxed);
+      Domain::collect();
+    }
+
+  private:
+    void run()
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (!stop_) {
+        lock.unlock();
+        Domain::collect();
+        lock.lock();
+        wake_.wait_for(lock, interval_, [this] { return stop_; });
+      }
+    }
+
+    std::chrono::milliseconds interval_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+    std::thread thread_;
+  };
+
+  MP_END_EXPORT
+}// namespace pointers
+}// namespace marcpawl
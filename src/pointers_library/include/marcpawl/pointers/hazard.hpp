@@ -0,0 +1,333 @@
+#pragma once
+
+#include "marcpawl/pointers/atomic.hpp"
+#include "marcpawl/pointers/core.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace marcpawl {
+namespace pointers {
+  MP_BEGIN_EXPORT
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  // hazard_domain, hazard_borrower
+  //
+  // Hazard pointers: a borrower of an object that another thread may
+  // replace and delete at any time.  The reader publishes the address it
+  // borrows in a hazard slot, and the writer retires the object it replaced
+  // instead of deleting it.  A retired object is deleted by a later scan
+  // once no slot holds its address:
+  //
+  //   atomic_strict_not_null<Config *> current{ ... };
+  //
+  //   // readers, lock free
+  //   hazard_borrower<Config *> config(current);
+  //   use(config->value);
+  //
+  //   // writer
+  //   Config *old = current.exchange(strict_not_null(new Config{})).get();
+  //   hazard_domain<>::retire(owner<Config *>(old));
+  //
+  // The source of a hazard_borrower is a std::atomic<T *>, an
+  // atomic_maybe_null<T *> or an atomic_strict_not_null<T *>.  An object
+  // must be retired once, after it can no longer be loaded from a source,
+  // and must have been replaced in the source by a seq_cst operation, the
+  // default.
+  //
+  // Slots are never freed, a thread keeps the ones it used for its next
+  // borrowers.  Each thread retires to its own list and scans it when it
+  // reaches twice the number of slots, so that the scan cost is amortized
+  // over as many retires.  Objects still retired when a thread exits are
+  // handed over to the next scan of any thread.
+  //
+  // Tag selects an independent domain, with its own slots and lists.
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename Tag = void> class hazard_domain;
+
+  template<details::RawPointer T, typename Domain = hazard_domain<>>
+  class hazard_borrower;
+
+  template<typename Tag> class hazard_domain
+  {
+  public:
+    // Retired objects scanned at once, at least.
+    static constexpr std::size_t min_scan = 64;
+
+    hazard_domain() = delete;
+
+    // Deletes object once no hazard_borrower holds it.
+    template<typename T> static void retire(owner<T *> object)
+    {
+      retire(object.get(), [](void *ptr) {
+        end_borrows(ptr);
+        delete static_cast<T *>(ptr);
+      });
+    }
+
+    // Calls deleter(object) once no hazard_borrower holds it.
+    static void retire(void *object, void (*deleter)(void *))
+    {
+      thread_state &local = state();
+      local.retired.push_back({ object, deleter });
+      if (local.retired.size()
+          >= std::max(min_scan,
+            2 * shared().slot_count.load(std::memory_order_relaxed))) {
+        scan(local);
+      }
+    }
+
+    // Deletes the retired objects of this thread, and those left by exited
+    // threads, that no hazard_borrower holds.
+    static void reclaim() { scan(state()); }
+
+    // Objects retired by this thread and not deleted yet.
+    [[nodiscard]] static std::size_t pending() noexcept
+    {
+      return state().retired.size();
+    }
+
+  private:
+    template<details::RawPointer U, typename D> friend class hazard_borrower;
+
+    // Released slots kept by a thread.
+    static constexpr std::size_t cached_slots = 4;
+
+    struct slot
+    {
+      std::atomic<void const *> hazard{ nullptr };
+      std::atomic<bool> in_use{ false };
+      slot *next = nullptr;
+    };
+
+    struct retired_object
+    {
+      void *object;
+      void (*deleter)(void *);
+    };
+
+    struct shared_state
+    {
+      std::atomic<slot *> slots{ nullptr };
+      std::atomic<std::size_t> slot_count{ 0 };
+      std::mutex orphans_mutex;
+      std::vector<retired_object> orphans;
+
+      // Only once the other threads are done with the domain.
+      ~shared_state()
+      {
+        for (auto const &r : orphans) { r.deleter(r.object); }
+        slot *s = slots.load(std::memory_order_acquire);
+        while (s != nullptr) {
+          slot *const next = s->next;
+          delete s;
+          s = next;
+        }
+      }
+    };
+
+    struct thread_state
+    {
+      std::vector<slot *> free_slots;
+      std::vector<retired_object> retired;
+
+      ~thread_state()
+      {
+        for (slot *const s : free_slots) {
+          s->in_use.store(false, std::memory_order_release);
+        }
+        if (!retired.empty()) { scan(*this); }
+        if (!retired.empty()) {
+          shared_state &domain = shared();
+          std::lock_guard<std::mutex> const lock(domain.orphans_mutex);
+          domain.orphans.insert(
+            domain.orphans.end(), retired.begin(), retired.end());
+        }
+      }
+    };
+
+    static shared_state &shared() noexcept
+    {
+      static shared_state domain;
+      return domain;
+    }
+
+    static thread_state &state() noexcept
+    {
+      thread_local thread_state local;
+      return local;
+    }
+
+    static slot &acquire_slot()
+    {
+      thread_state &local = state();
+      if (!local.free_slots.empty()) {
+        slot *const s = local.free_slots.back();
+        local.free_slots.pop_back();
+        return *s;
+      }
+      local.free_slots.reserve(cached_slots);
+      shared_state &domain = shared();
+      for (slot *s = domain.slots.load(std::memory_order_acquire); s != nullptr;
+           s = s->next) {
+        bool expected = false;
+        if (!s->in_use.load(std::memory_order_relaxed)
+            && s->in_use.compare_exchange_strong(
+              expected, true, std::memory_order_acquire)) {
+          return *s;
+        }
+      }
+      auto *const s = new slot;
+      s->in_use.store(true, std::memory_order_relaxed);
+      s->next = domain.slots.load(std::memory_order_relaxed);
+      while (!domain.slots.compare_exchange_weak(
+        s->next, s, std::memory_order_release, std::memory_order_relaxed)) {}
+      domain.slot_count.fetch_add(1, std::memory_order_relaxed);
+      return *s;
+    }
+
+    // Kept by the thread when there is room, so that releasing does not
+    // allocate.
+    static void release_slot(slot &s) noexcept
+    {
+      s.hazard.store(nullptr, std::memory_order_release);
+      thread_state &local = state();
+      if (local.free_slots.size() < local.free_slots.capacity()) {
+        local.free_slots.push_back(&s);
+      } else {
+        s.in_use.store(false, std::memory_order_release);
+      }
+    }
+
+    static void scan(thread_state &local)
+    {
+      shared_state &domain = shared();
+      {
+        std::unique_lock<std::mutex> const lock(
+          domain.orphans_mutex, std::try_to_lock);
+        if (lock.owns_lock() && !domain.orphans.empty()) {
+          local.retired.insert(
+            local.retired.end(), domain.orphans.begin(), domain.orphans.end());
+          domain.orphans.clear();
+        }
+      }
+
+      std::vector<void const *> hazards;
+      hazards.reserve(domain.slot_count.load(std::memory_order_relaxed));
+      for (slot *s = domain.slots.load(std::memory_order_acquire); s != nullptr;
+           s = s->next) {
+        // seq_cst, as the hazard stores and the replacement of the object:
+        // either the reader sees that the object was replaced, or the scan
+        // sees its hazard.
+        void const *const hazard = s->hazard.load(std::memory_order_seq_cst);
+        if (hazard != nullptr) { hazards.push_back(hazard); }
+      }
+      std::sort(hazards.begin(), hazards.end());
+
+      auto const held = std::partition(local.retired.begin(),
+        local.retired.end(),
+        [&hazards](retired_object const &r) {
+          return std::binary_search(hazards.begin(), hazards.end(), r.object);
+        });
+      std::vector<retired_object> const reclaimable(held, local.retired.end());
+      local.retired.erase(held, local.retired.end());
+      for (auto const &r : reclaimable) { r.deleter(r.object); }
+    }
+  };
+
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  // hazard_borrower
+  //
+  // Borrows the object held by an atomic source and keeps it from being
+  // deleted by Domain::retire() until the borrower is destroyed or reset.
+  // Move only.  Holds null when the source did.
+  ////////////////////////////////////////////////////////////////////////////
+  template<details::RawPointer T, typename Domain> class hazard_borrower
+  {
+  public:
+    hazard_borrower() noexcept = default;
+
+    template<typename Source>
+    explicit hazard_borrower(Source const &source)
+      : slot_(&Domain::acquire_slot())
+    {
+      protect(source);
+    }
+
+    hazard_borrower(hazard_borrower &&other) noexcept
+      : slot_(std::exchange(other.slot_, nullptr)),
+        ptr_(std::exchange(other.ptr_, nullptr))
+    {}
+
+    hazard_borrower &operator=(hazard_borrower &&other) noexcept
+    {
+      if (this != &other) {
+        reset();
+        slot_ = std::exchange(other.slot_, nullptr);
+        ptr_ = std::exchange(other.ptr_, nullptr);
+      }
+      return *this;
+    }
+
+    hazard_borrower(hazard_borrower const &) = delete;
+    hazard_borrower &operator=(hazard_borrower const &) = delete;
+
+    ~hazard_borrower() { reset(); }
+
+    // Borrows the current object of source instead, with the same slot.
+    template<typename Source> void protect(Source const &source)
+    {
+      if (slot_ == nullptr) { slot_ = &Domain::acquire_slot(); }
+      T ptr = details::load_pointer(source, std::memory_order_acquire);
+      for (;;) {
+        slot_->hazard.store(ptr, std::memory_order_seq_cst);
+        T const again =
+          details::load_pointer(source, std::memory_order_seq_cst);
+        if (again == ptr) { break; }
+        ptr = again;
+      }
+      ptr_ = ptr;
+    }
+
+    // Stops borrowing, the object may be deleted from now on.
+    void reset() noexcept
+    {
+      if (slot_ != nullptr) {
+        Domain::release_slot(*slot_);
+        slot_ = nullptr;
+      }
+      ptr_ = nullptr;
+    }
+
+    [[nodiscard]] maybe_null<T> get() const noexcept
+    {
+      return maybe_null<T>(ptr_);
+    }
+
+    // A borrower valid as long as this hazard_borrower.
+    [[nodiscard]] borrower<T> borrow() const noexcept
+    {
+      return borrower<T>(ptr_);
+    }
+
+    explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+    // Undefined when null.
+    T operator->() const noexcept { return ptr_; }
+    decltype(auto) operator*() const noexcept { return *ptr_; }
+
+  private:
+    typename Domain::slot *slot_ = nullptr;
+    T ptr_ = nullptr;
+  };
+
+  MP_END_EXPORT
+}// namespace pointers
+}// namespace marcpawl
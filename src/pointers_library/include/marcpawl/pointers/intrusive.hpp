@@ -0,0 +1,250 @@
+#pragma once
+
+#include "marcpawl/pointers/core.hpp"
+
+#include <atomic>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace marcpawl {
+namespace pointers {
+  MP_BEGIN_EXPORT
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  // ref_counted, intrusive_ptr
+  //
+  // A shared pointer whose reference count is a member of the object, so
+  // that there is no separate control block and intrusive_ptr has the size
+  // of a raw pointer:
+  //
+  //   struct Route : ref_counted<Route> { ... };
+  //
+  //   strict_not_null<intrusive_ptr<Route>> route(make_intrusive<Route>());
+  //   borrower<Route *> hop(route.get());// the count is left alone
+  //
+  // The count is atomic, or a plain integer with
+  // ref_counted<T, ref_counting::single_thread> for objects that are only
+  // ever shared within a thread.
+  //
+  // intrusive_ptr<T> finds the count with intrusive_ptr_add_ref(T const *)
+  // and intrusive_ptr_release(T const *), looked up by ADL, as with
+  // boost::intrusive_ptr.  ref_counted provides them, a class with a count
+  // of its own can provide them instead.
+  //
+  // intrusive_ptr works with maybe_null, strict_not_null and owner.  A
+  // borrower<T *> is made from it without touching the count.
+  ////////////////////////////////////////////////////////////////////////////
+
+  enum class ref_counting { atomic, single_thread };
+
+  template<typename T, ref_counting Counting = ref_counting::atomic>
+  class ref_counted
+  {
+  public:
+    using count_type = std::size_t;
+
+    [[nodiscard]] count_type use_count() const noexcept
+    {
+      if constexpr (Counting == ref_counting::atomic) {
+        return count_.load(std::memory_order_relaxed);
+      } else {
+        return count_;
+      }
+    }
+
+  protected:
+    constexpr ref_counted() noexcept = default;
+
+    // A copy of an object is not shared yet.
+    constexpr ref_counted(ref_counted const & /*other*/) noexcept {}
+    constexpr ref_counted &operator=(ref_counted const & /*other*/) noexcept
+    {
+      return *this;
+    }
+
+    ~ref_counted() = default;
+
+  private:
+    friend void intrusive_ptr_add_ref(ref_counted const *object) noexcept
+    {
+      if constexpr (Counting == ref_counting::atomic) {
+        object->count_.fetch_add(1, std::memory_order_relaxed);
+      } else {
+        ++object->count_;
+      }
+    }
+
+    friend void intrusive_ptr_release(ref_counted const *object) noexcept
+    {
+      if constexpr (Counting == ref_counting::atomic) {
+        if (object->count_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+          return;
+        }
+      } else {
+        if (--object->count_ != 0) { return; }
+      }
+      delete static_cast<T const *>(object);
+    }
+
+    mutable std::conditional_t<Counting == ref_counting::atomic,
+      std::atomic<count_type>,
+      count_type>
+      count_{ 0 };
+  };
+
+  MP_END_EXPORT
+
+  namespace details {
+    // The T of the ref_counted<T> base of a class, void without one.
+    template<typename T, ref_counting Counting>
+    T ref_counted_of(ref_counted<T, Counting> const *);
+    void ref_counted_of(void const *);
+
+    // ref_counted<T> deletes the object as a T, which is only defined for
+    // an object of a class derived from T when T has a virtual destructor.
+    template<typename U> consteval bool deleted_as_itself()
+    {
+      using counted =
+        decltype(details::ref_counted_of(static_cast<U *>(nullptr)));
+      return std::is_void_v<counted>
+             || std::is_same_v<std::remove_cv_t<U>, counted>
+             || std::has_virtual_destructor_v<counted>;
+    }
+  }// namespace details
+
+  MP_BEGIN_EXPORT
+
+  // Selects the constructor of intrusive_ptr that takes over a reference
+  // already counted, e.g. one released by intrusive_ptr#detach().
+  struct adopt_ref_t
+  {
+    explicit adopt_ref_t() = default;
+  };
+  inline constexpr adopt_ref_t adopt_ref{};
+
+
+  template<typename T> class intrusive_ptr
+  {
+  public:
+    using element_type = T;
+
+    constexpr intrusive_ptr() noexcept = default;
+    constexpr intrusive_ptr(std::nullptr_t) noexcept {}
+
+    explicit intrusive_ptr(T *ptr) noexcept : ptr_(ptr)
+    {
+      if (ptr_ != nullptr) { intrusive_ptr_add_ref(ptr_); }
+    }
+
+    intrusive_ptr(adopt_ref_t, T *ptr) noexcept : ptr_(ptr) {}
+
+    intrusive_ptr(intrusive_ptr const &other) noexcept
+      : intrusive_ptr(other.ptr_)
+    {}
+
+    intrusive_ptr(intrusive_ptr &&other) noexcept
+      : ptr_(std::exchange(other.ptr_, nullptr))
+    {}
+
+    template<typename U>
+      requires std::is_convertible_v<U *, T *>
+    intrusive_ptr(intrusive_ptr<U> const &other) noexcept
+      : intrusive_ptr(other.get())
+    {
+      static_assert(details::deleted_as_itself<U>(),
+        "the ref_counted base of U needs a virtual destructor");
+    }
+
+    template<typename U>
+      requires std::is_convertible_v<U *, T *>
+    intrusive_ptr(intrusive_ptr<U> &&other) noexcept
+      : ptr_(other.detach())
+    {
+      static_assert(details::deleted_as_itself<U>(),
+        "the ref_counted base of U needs a virtual destructor");
+    }
+
+    ~intrusive_ptr()
+    {
+      if (ptr_ != nullptr) { intrusive_ptr_release(ptr_); }
+    }
+
+    // Leaves the count alone when both already point to the same object.
+    intrusive_ptr &operator=(intrusive_ptr const &other) noexcept
+    {
+      if (ptr_ != other.ptr_) { intrusive_ptr(other).swap(*this); }
+      return *this;
+    }
+
+    intrusive_ptr &operator=(intrusive_ptr &&other) noexcept
+    {
+      intrusive_ptr(std::move(other)).swap(*this);
+      return *this;
+    }
+
+    intrusive_ptr &operator=(std::nullptr_t) noexcept
+    {
+      reset();
+      return *this;
+    }
+
+    void reset() noexcept { intrusive_ptr().swap(*this); }
+
+    void swap(intrusive_ptr &other) noexcept { std::swap(ptr_, other.ptr_); }
+
+    // Gives up the pointer without releasing its reference.
+    [[nodiscard]] T *detach() noexcept { return std::exchange(ptr_, nullptr); }
+
+    [[nodiscard]] T *get() const noexcept { return ptr_; }
+    T &operator*() const noexcept { return *ptr_; }
+    T *operator->() const noexcept { return ptr_; }
+    explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+    friend bool operator==(intrusive_ptr const &lhs, std::nullptr_t) noexcept
+    {
+      return lhs.ptr_ == nullptr;
+    }
+
+    template<typename U>
+    friend bool operator==(intrusive_ptr const &lhs,
+      intrusive_ptr<U> const &rhs) noexcept
+    {
+      return lhs.get() == rhs.get();
+    }
+
+    template<typename U>
+    friend auto operator<=>(intrusive_ptr const &lhs,
+      intrusive_ptr<U> const &rhs) noexcept
+    {
+      return std::compare_three_way{}(lhs.get(), rhs.get());
+    }
+
+  private:
+    T *ptr_ = nullptr;
+  };
+
+
+  template<typename T, typename... Args>
+  [[nodiscard]] intrusive_ptr<T> make_intrusive(Args &&...args)
+  {
+    static_assert(details::deleted_as_itself<T>(),
+      "the ref_counted base of T needs a virtual destructor");
+    return intrusive_ptr<T>(new T(std::forward<Args>(args)...));
+  }
+
+  MP_END_EXPORT
+}// namespace pointers
+}// namespace marcpawl
+
+template<typename T> struct std::hash<marcpawl::pointers::intrusive_ptr<T>>
+{
+  std::size_t operator()(
+    marcpawl::pointers::intrusive_ptr<T> const &p) const noexcept
+  {
+    return std::hash<T *>{}(p.get());
+  }
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+// Stream output of the pointer wrappers, which print the pointer they hold.
+
+#include "marcpawl/pointers/core.hpp"
+
+#include <ostream>
+
+namespace marcpawl {
+namespace pointers {
+  MP_BEGIN_EXPORT
+  template<class T>
+  std::ostream &operator<<(std::ostream &os, wrapped_pointer<T> const &val)
+  {
+    os << val.get();
+    return os;
+  }
+
+  template<class T>
+  std::ostream &operator<<(std::ostream &os, owner<T> const &val)
+  {
+    os << val.get();
+    return os;
+  }
+
+  MP_END_EXPORT
+}// namespace pointers
+}// namespace marcpawl
@@ -0,0 +1,826 @@
+#pragma once
+
+#include "marcpawl/pointers/core.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if !defined(MP_NO_SIMD)                                                    \
+  && (defined(__SSE2__) || defined(_M_X64)                                  \
+      || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define MP_POINTER_SET_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace marcpawl {
+namespace pointers {
+  namespace details {
+    ////////////////////////////////////////////////////////////////////////////
+    // Control bytes
+    //
+    // One byte per slot, probed a group at a time.  A full slot holds the top
+    // 7 bits of the hash of its key, so that a whole group is compared with
+    // a single SIMD compare before any key is loaded.
+    ////////////////////////////////////////////////////////////////////////////
+    using ctrl_t = std::int8_t;
+    inline constexpr ctrl_t ctrl_empty = -128;// 0b10000000
+    inline constexpr ctrl_t ctrl_deleted = -2;// 0b11111110
+
+    // Slots of a group selected by a match, Shift is log2 of the number of
+    // bits used per slot.
+    template<int Shift> class group_mask
+    {
+    public:
+      explicit constexpr group_mask(std::uint64_t bits) noexcept : bits_(bits)
+      {}
+
+      explicit constexpr operator bool() const noexcept { return bits_ != 0; }
+
+      [[nodiscard]] constexpr std::size_t lowest() const noexcept
+      {
+        return static_cast<std::size_t>(std::countr_zero(bits_)) >> Shift;
+      }
+
+      constexpr void remove_lowest() noexcept { bits_ &= bits_ - 1; }
+
+    private:
+      std::uint64_t bits_;
+    };
+
+#if defined(MP_POINTER_SET_SSE2)
+    class group
+    {
+    public:
+      static constexpr std::size_t width = 16;
+      using mask = group_mask<0>;
+
+      explicit group(ctrl_t const *ctrl) noexcept
+        : ctrl_(_mm_loadu_si128(reinterpret_cast<__m128i const *>(ctrl)))
+      {}
+
+      [[nodiscard]] mask match(ctrl_t h2) const noexcept
+      {
+        return bits(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_));
+      }
+
+      [[nodiscard]] mask match_empty() const noexcept
+      {
+        return match(ctrl_empty);
+      }
+
+      // Empty or deleted, both are below -1.
+      [[nodiscard]] mask match_free() const noexcept
+      {
+        return bits(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl_));
+      }
+
+    private:
+      static mask bits(__m128i matched) noexcept
+      {
+        return mask(static_cast<std::uint32_t>(_mm_movemask_epi8(matched)));
+      }
+
+      __m128i ctrl_;
+    };
+#else
+    // Eight control bytes in a 64 bit word.  match() can report a false
+    // positive next to a real one, which is harmless since the keys are
+    // compared anyway.
+    class group
+    {
+    public:
+      static constexpr std::size_t width = 8;
+      using mask = group_mask<3>;
+
+      explicit group(ctrl_t const *ctrl) noexcept : ctrl_(0)
+      {
+        for (std::size_t i = 0; i < width; ++i) {
+          ctrl_ |= std::uint64_t{ static_cast<std::uint8_t>(ctrl[i]) }
+                   << (8 * i);
+        }
+      }
+
+      [[nodiscard]] mask match(ctrl_t h2) const noexcept
+      {
+        auto const x = ctrl_ ^ (lsbs * static_cast<std::uint8_t>(h2));
+        return mask((x - lsbs) & ~x & msbs);
+      }
+
+      [[nodiscard]] mask match_empty() const noexcept
+      {
+        return mask(ctrl_ & ~(ctrl_ << 6) & msbs);
+      }
+
+      [[nodiscard]] mask match_free() const noexcept
+      {
+        return mask(ctrl_ & ~(ctrl_ << 7) & msbs);
+      }
+
+    private:
+      static constexpr std::uint64_t lsbs = 0x0101010101010101ULL;
+      static constexpr std::uint64_t msbs = 0x8080808080808080ULL;
+
+      std::uint64_t ctrl_;
+    };
+#endif
+
+    // What iterating over a pointer_table yields.
+    template<typename W, typename V> struct table_entry
+    {
+      using value_type = std::pair<W const, std::remove_const_t<V>>;
+      using reference = std::pair<W const, V &>;
+    };
+
+    template<typename W> struct table_entry<W, void>
+    {
+      using value_type = W;
+      using reference = W;
+    };
+
+    template<typename W>
+    struct table_entry<W, void const> : table_entry<W, void>
+    {
+    };
+
+    // An array of `count` uninitialized T that is freed unless released.
+    template<typename T> class allocation
+    {
+    public:
+      explicit allocation(std::size_t count)
+        : data_(std::allocator<T>{}.allocate(count)), count_(count)
+      {}
+      allocation(allocation const &) = delete;
+      allocation &operator=(allocation const &) = delete;
+      ~allocation()
+      {
+        if (data_ != nullptr) { std::allocator<T>{}.deallocate(data_, count_); }
+      }
+
+      [[nodiscard]] T *get() const noexcept { return data_; }
+      T *release() noexcept { return std::exchange(data_, nullptr); }
+
+    private:
+      T *data_;
+      std::size_t count_;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // pointer_table
+    //
+    // Open addressing table of raw pointers shared by pointer_set and
+    // pointer_map, V is void for a set.
+    //
+    // The keys are stored as raw pointers in their own array, and a null
+    // pointer marks a slot without a key.  Iteration only looks at that
+    // array, and a false match in a group is rejected by the key compare.
+    // Null keys are therefore rejected.
+    ////////////////////////////////////////////////////////////////////////////
+    template<WrappedRawPointer W, typename V> class pointer_table
+    {
+    public:
+      using key_type = W;
+      using size_type = std::size_t;
+      using difference_type = std::ptrdiff_t;
+      using pointer = decltype(W::ptr_);
+      using element_type = std::remove_pointer_t<pointer>;
+
+    protected:
+      static constexpr bool is_map = !std::is_void_v<V>;
+      using mapped_storage = std::conditional_t<is_map, V, unsigned char>;
+
+    private:
+      template<bool Const> class basic_iterator;
+
+    public:
+      using iterator = basic_iterator<!is_map>;
+      using const_iterator = basic_iterator<true>;
+
+      pointer_table() noexcept = default;
+
+      explicit pointer_table(size_type capacity) { reserve(capacity); }
+
+      // Delegates so that the destructor releases what was copied when a
+      // value throws, a key is only stored once its value is constructed.
+      pointer_table(pointer_table const &other) : pointer_table()
+      {
+        if (other.size_ == 0) { return; }
+        allocate(other.capacity_);
+        std::copy_n(other.ctrl_, ctrl_size(capacity_), ctrl_);
+        if constexpr (is_map) {
+          for (size_type i = 0; i < capacity_; ++i) {
+            if (other.keys_[i] != nullptr) {
+              std::construct_at(values_ + i, other.values_[i]);
+              keys_[i] = other.keys_[i];
+            }
+          }
+        } else {
+          std::copy_n(other.keys_, capacity_, keys_);
+        }
+        size_ = other.size_;
+        growth_left_ = other.growth_left_;
+      }
+
+      pointer_table(pointer_table &&other) noexcept
+        : ctrl_(std::exchange(other.ctrl_, nullptr)),
+          keys_(std::exchange(other.keys_, nullptr)),
+          values_(std::exchange(other.values_, nullptr)),
+          capacity_(std::exchange(other.capacity_, 0)),
+          size_(std::exchange(other.size_, 0)),
+          growth_left_(std::exchange(other.growth_left_, 0))
+      {}
+
+      pointer_table &operator=(pointer_table const &other)
+      {
+        if (this != &other) {
+          pointer_table copy(other);
+          swap(copy);
+        }
+        return *this;
+      }
+
+      pointer_table &operator=(pointer_table &&other) noexcept
+      {
+        pointer_table moved(std::move(other));
+        swap(moved);
+        return *this;
+      }
+
+      ~pointer_table() { release(); }
+
+      void swap(pointer_table &other) noexcept
+      {
+        std::swap(ctrl_, other.ctrl_);
+        std::swap(keys_, other.keys_);
+        std::swap(values_, other.values_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+        std::swap(growth_left_, other.growth_left_);
+      }
+
+      [[nodiscard]] size_type size() const noexcept { return size_; }
+      [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+      [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+
+      iterator begin() noexcept { return iterator(this, next_key(0)); }
+      iterator end() noexcept { return iterator(this, capacity_); }
+      const_iterator begin() const noexcept
+      {
+        return const_iterator(this, next_key(0));
+      }
+      const_iterator end() const noexcept
+      {
+        return const_iterator(this, capacity_);
+      }
+      const_iterator cbegin() const noexcept { return begin(); }
+      const_iterator cend() const noexcept { return end(); }
+
+      void clear() noexcept
+      {
+        destroy_values();
+        if (capacity_ != 0) {
+          std::fill_n(ctrl_, ctrl_size(capacity_), ctrl_empty);
+          std::fill_n(keys_, capacity_, nullptr);
+        }
+        size_ = 0;
+        growth_left_ = max_load(capacity_);
+      }
+
+      // Makes room for `count` keys without rehashing.
+      void reserve(size_type count)
+      {
+        if (count > max_load(capacity_)) { rehash(capacity_for(count)); }
+      }
+
+      // Lookup with a raw pointer, a smart pointer or any wrapper, no
+      // temporary key is built.  Null is never found.
+      template<typename Q> iterator find(Q const &key) noexcept
+      {
+        return iterator(this, find_index(details::raw_pointer_of(key)));
+      }
+
+      template<typename Q> const_iterator find(Q const &key) const noexcept
+      {
+        return const_iterator(this, find_index(details::raw_pointer_of(key)));
+      }
+
+      template<typename Q>
+      [[nodiscard]] bool contains(Q const &key) const noexcept
+      {
+        return find_index(details::raw_pointer_of(key)) != capacity_;
+      }
+
+      template<typename Q>
+      [[nodiscard]] size_type count(Q const &key) const noexcept
+      {
+        return contains(key) ? 1 : 0;
+      }
+
+      template<typename Q> size_type erase(Q const &key) noexcept
+      {
+        auto const index = find_index(details::raw_pointer_of(key));
+        if (index == capacity_) { return 0; }
+        erase_index(index);
+        return 1;
+      }
+
+      iterator erase(const_iterator position) noexcept
+      {
+        erase_index(position.index_);
+        return iterator(this, next_key(position.index_ + 1));
+      }
+
+    protected:
+      // Index of the slot holding `key`, and whether it was just inserted.
+      // A new slot has its key set, its value is for the caller to construct.
+      std::pair<size_type, bool> find_or_prepare_insert(pointer key)
+      {
+        if (key == nullptr) {
+          details::fatal_null_violation(
+            "null pointer_set key", std::source_location::current());
+        }
+        if (capacity_ == 0) { rehash(group::width); }
+        auto const h = hash(key);
+        auto target = capacity_;
+        for (probe seq(h1(h), mask());; seq.next()) {
+          group const g(ctrl_ + seq.offset());
+          for (auto m = g.match(h2(h)); m; m.remove_lowest()) {
+            auto const index = seq.slot(m.lowest());
+            if (keys_[index] == key) { return { index, false }; }
+          }
+          if (target == capacity_) {
+            if (auto free = g.match_free()) {
+              target = seq.slot(free.lowest());
+            }
+          }
+          if (g.match_empty()) { break; }
+        }
+        if (ctrl_[target] == ctrl_empty) {
+          if (growth_left_ == 0) {
+            rehash(size_ < max_load(capacity_) / 2 ? capacity_
+                                                     : 2 * capacity_);
+            target = find_free(h);
+          }
+          --growth_left_;
+        }
+        set_ctrl(target, h2(h));
+        keys_[target] = key;
+        ++size_;
+        return { target, true };
+      }
+
+      // Undoes find_or_prepare_insert when constructing the value threw.
+      void abandon_insert(size_type index) noexcept
+      {
+        keys_[index] = nullptr;
+        set_ctrl(index, ctrl_deleted);
+        --size_;
+      }
+
+      template<typename Q>
+      [[nodiscard]] size_type find_index(Q const *key) const noexcept
+      {
+        element_type const volatile *const address = key;
+        if (address == nullptr || size_ == 0) { return capacity_; }
+        auto const h = hash(address);
+        for (probe seq(h1(h), mask());; seq.next()) {
+          group const g(ctrl_ + seq.offset());
+          for (auto m = g.match(h2(h)); m; m.remove_lowest()) {
+            auto const index = seq.slot(m.lowest());
+            if (keys_[index] == address) { return index; }
+          }
+          if (g.match_empty()) { return capacity_; }
+        }
+      }
+
+      mapped_storage &value_at(size_type index) noexcept
+      {
+        return values_[index];
+      }
+
+      mapped_storage *value_address(size_type index) noexcept
+      {
+        return values_ + index;
+      }
+
+      iterator iterator_at(size_type index) noexcept
+      {
+        return iterator(this, index);
+      }
+
+      // The key as it was inserted, without running the constructor of W
+      // again: a strict_not_null is not tested, and an owner does not start
+      // a new lifetime for a deleted object, see MP_BORROW_CHECKS.
+      static W make_key(pointer key)
+      {
+        if constexpr (details::is_strict_not_null<W>::value) {
+          return W{ assume_not_null, key };
+        }
+#if defined(MP_BORROW_CHECKS)
+        else if constexpr (details::is_borrow_checked<W>::value) {
+          return details::borrow_access::make<W>(
+            key, details::borrow_table::stamp(key));
+        }
+#endif
+        else {
+          return W{ key };
+        }
+      }
+
+    private:
+      // Groups are visited in triangular order, which visits every group of
+      // a power of two capacity once.
+      class probe
+      {
+      public:
+        probe(std::size_t hash, std::size_t mask) noexcept
+          : mask_(mask), offset_(hash & mask)
+        {}
+
+        [[nodiscard]] std::size_t offset() const noexcept { return offset_; }
+
+        [[nodiscard]] std::size_t slot(std::size_t i) const noexcept
+        {
+          return (offset_ + i) & mask_;
+        }
+
+        void next() noexcept
+        {
+          index_ += group::width;
+          offset_ = (offset_ + index_) & mask_;
+        }
+
+      private:
+        std::size_t mask_;
+        std::size_t offset_;
+        std::size_t index_ = 0;
+      };
+
+      // The low bits of a pointer are zero because of alignment and are
+      // dropped, a multiply then spreads the rest towards the high bits.
+      // Only the high bits of the product are well mixed, the high half is
+      // folded into the low half for the probe and the control byte is taken
+      // from the top bits, so that keys a large power of two apart still
+      // differ in both.
+      static std::size_t hash(element_type const volatile *key) noexcept
+      {
+        constexpr int shift = std::countr_zero(alignof(element_type));
+        constexpr std::size_t multiplier =
+          sizeof(std::size_t) == 8 ? 0x9e3779b97f4a7c15ULL : 0x9e3779b9UL;
+        std::size_t const bits = reinterpret_cast<std::uintptr_t>(key) >> shift;
+        constexpr int half = std::numeric_limits<std::size_t>::digits / 2;
+        std::size_t const product = bits * multiplier;
+        return product ^ (product >> half);
+      }
+
+      static std::size_t h1(std::size_t hash) noexcept { return hash; }
+      static ctrl_t h2(std::size_t hash) noexcept
+      {
+        return static_cast<ctrl_t>(
+          hash >> (std::numeric_limits<std::size_t>::digits - 7));
+      }
+
+      // At most 7/8 full.
+      static size_type max_load(size_type capacity) noexcept
+      {
+        return capacity - capacity / 8;
+      }
+
+      static size_type capacity_for(size_type count) noexcept
+      {
+        auto const needed = count + (count + 6) / 7;
+        return std::max(group::width, std::bit_ceil(needed));
+      }
+
+      // The first group::width - 1 control bytes are repeated after the last
+      // one, so that a group can be loaded at any slot.
+      static size_type ctrl_size(size_type capacity) noexcept
+      {
+        return capacity + group::width - 1;
+      }
+
+      [[nodiscard]] std::size_t mask() const noexcept { return capacity_ - 1; }
+
+      void set_ctrl(size_type index, ctrl_t value) noexcept
+      {
+        ctrl_[index] = value;
+        if (index < group::width - 1) { ctrl_[capacity_ + index] = value; }
+      }
+
+      size_type find_free(std::size_t h) const noexcept
+      {
+        for (probe seq(h1(h), mask());; seq.next()) {
+          if (auto free = group(ctrl_ + seq.offset()).match_free()) {
+            return seq.slot(free.lowest());
+          }
+        }
+      }
+
+      void erase_index(size_type index) noexcept
+      {
+        if constexpr (is_map) { std::destroy_at(values_ + index); }
+        keys_[index] = nullptr;
+        set_ctrl(index, ctrl_deleted);
+        --size_;
+      }
+
+      [[nodiscard]] size_type next_key(size_type index) const noexcept
+      {
+        while (index < capacity_ && keys_[index] == nullptr) { ++index; }
+        return index;
+      }
+
+      // Gives an empty table `capacity` slots, nothing is changed when an
+      // allocation throws.
+      void allocate(size_type capacity)
+      {
+        allocation<ctrl_t> ctrl(ctrl_size(capacity));
+        allocation<pointer> keys(capacity);
+        if constexpr (is_map) {
+          values_ = std::allocator<mapped_storage>{}.allocate(capacity);
+        }
+        ctrl_ = ctrl.release();
+        std::fill_n(ctrl_, ctrl_size(capacity), ctrl_empty);
+        keys_ = keys.release();
+        std::fill_n(keys_, capacity, nullptr);
+        capacity_ = capacity;
+        growth_left_ = max_load(capacity);
+      }
+
+      void destroy_values() noexcept
+      {
+        if constexpr (is_map && !std::is_trivially_destructible_v<V>) {
+          for (size_type i = 0; i < capacity_; ++i) {
+            if (keys_[i] != nullptr) { std::destroy_at(values_ + i); }
+          }
+        }
+      }
+
+      void release() noexcept
+      {
+        if (capacity_ == 0) { return; }
+        destroy_values();
+        std::allocator<ctrl_t>{}.deallocate(ctrl_, ctrl_size(capacity_));
+        std::allocator<pointer>{}.deallocate(keys_, capacity_);
+        if constexpr (is_map) {
+          std::allocator<mapped_storage>{}.deallocate(values_, capacity_);
+        }
+      }
+
+      // Reinserts every key into a table of `capacity` slots, which also
+      // drops the deleted markers.  The new table only replaces this one
+      // once it is complete, so a throwing allocation or value copy leaves
+      // this table as it was.
+      void rehash(size_type capacity)
+      {
+        pointer_table table;
+        table.allocate(capacity);
+        for (size_type i = 0; i < capacity_; ++i) {
+          auto const key = keys_[i];
+          if (key == nullptr) { continue; }
+          auto const h = hash(key);
+          auto const index = table.find_free(h);
+          if constexpr (is_map) {
+            std::construct_at(table.values_ + index,
+              std::move_if_noexcept(values_[i]));
+          }
+          table.set_ctrl(index, h2(h));
+          table.keys_[index] = key;
+        }
+        table.size_ = size_;
+        table.growth_left_ -= size_;
+        swap(table);
+      }
+
+      ctrl_t *ctrl_ = nullptr;
+      pointer *keys_ = nullptr;
+      mapped_storage *values_ = nullptr;
+      size_type capacity_ = 0;
+      size_type size_ = 0;
+      size_type growth_left_ = 0;
+    };
+
+    template<WrappedRawPointer W, typename V>
+    template<bool Const>
+    class pointer_table<W, V>::basic_iterator
+    {
+      using table =
+        std::conditional_t<Const, pointer_table const, pointer_table>;
+      using entry = table_entry<W, std::conditional_t<Const, V const, V>>;
+
+    public:
+      using iterator_concept = std::forward_iterator_tag;
+      using iterator_category = std::input_iterator_tag;
+      using difference_type = std::ptrdiff_t;
+      using value_type = typename entry::value_type;
+      // Keys are stored as raw pointers, a wrapper is made on the fly.
+      using reference = typename entry::reference;
+
+      class pointer
+      {
+      public:
+        explicit pointer(reference ref) : ref_(std::move(ref)) {}
+        reference const *operator->() const noexcept { return &ref_; }
+
+      private:
+        reference ref_;
+      };
+
+      basic_iterator() noexcept = default;
+
+      // iterator converts to const_iterator.
+      template<bool OtherConst>
+        requires(Const && !OtherConst)
+      basic_iterator(basic_iterator<OtherConst> const &other) noexcept
+        : table_(other.table_), index_(other.index_)
+      {}
+
+      reference operator*() const
+      {
+        if constexpr (is_map) {
+          return reference(make_key(table_->keys_[index_]),
+            table_->values_[index_]);
+        } else {
+          return make_key(table_->keys_[index_]);
+        }
+      }
+
+      pointer operator->() const { return pointer(**this); }
+
+      basic_iterator &operator++() noexcept
+      {
+        index_ = table_->next_key(index_ + 1);
+        return *this;
+      }
+
+      basic_iterator operator++(int) noexcept
+      {
+        auto previous = *this;
+        ++*this;
+        return previous;
+      }
+
+      friend bool operator==(basic_iterator const &lhs,
+        basic_iterator const &rhs) noexcept
+      {
+        return lhs.index_ == rhs.index_;
+      }
+
+    private:
+      basic_iterator(table *owner, size_type index) noexcept
+        : table_(owner), index_(index)
+      {}
+
+      table *table_ = nullptr;
+      size_type index_ = 0;
+
+      friend class pointer_table;
+      template<bool> friend class basic_iterator;
+    };
+  }// namespace details
+
+  MP_BEGIN_EXPORT
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  // pointer_set
+  //
+  // Flat open addressing set of pointers, keyed by a wrapper around a raw
+  // pointer, e.g. pointer_set<borrower<Node *>>.
+  //
+  // Replaces std::unordered_set for identity sets: there is no node per key,
+  // the keys are stored as raw pointers with one control byte each, and a
+  // lookup compares a whole group of control bytes at once.
+  //
+  // A null pointer marks an empty slot, so null keys are rejected as a null
+  // violation that cannot be carried on from, see MP_NULL_POLICY.
+  // strict_not_null keys never are.
+  //
+  // Iterators return the key by value, and are invalidated by any insertion.
+  ////////////////////////////////////////////////////////////////////////////
+  template<details::WrappedRawPointer W>
+  class pointer_set : public details::pointer_table<W, void>
+  {
+    using table = details::pointer_table<W, void>;
+
+  public:
+    using value_type = W;
+    using typename table::iterator;
+    using typename table::size_type;
+
+    using table::table;
+
+    pointer_set() noexcept = default;
+
+    pointer_set(std::initializer_list<W> keys) : table(keys.size())
+    {
+      for (auto const &key : keys) { insert(key); }
+    }
+
+    std::pair<iterator, bool> insert(W const &key)
+    {
+      auto const [index, inserted] = this->find_or_prepare_insert(key.ptr_);
+      return { this->iterator_at(index), inserted };
+    }
+  };
+
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  // pointer_map
+  //
+  // Flat open addressing map from pointers, keyed by a wrapper around a raw
+  // pointer, e.g. pointer_map<borrower<Node *>, Entry>.  Works like
+  // pointer_set, the values are kept in a separate array so that probing
+  // only touches the control bytes and the keys.
+  //
+  // Iterators return std::pair<W const, V &> by value.
+  ////////////////////////////////////////////////////////////////////////////
+  template<details::WrappedRawPointer W, typename V>
+  class pointer_map : public details::pointer_table<W, V>
+  {
+    using table = details::pointer_table<W, V>;
+
+  public:
+    using mapped_type = V;
+    using value_type = std::pair<W const, V>;
+    using typename table::iterator;
+    using typename table::const_iterator;
+    using typename table::size_type;
+
+    using table::table;
+
+    pointer_map() noexcept = default;
+
+    pointer_map(std::initializer_list<value_type> values)
+      : table(values.size())
+    {
+      for (auto const &value : values) { insert(value); }
+    }
+
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(W const &key, Args &&...args)
+    {
+      auto const [index, inserted] = this->find_or_prepare_insert(key.ptr_);
+      if (inserted) {
+#if defined(MP_NO_EXCEPTIONS)
+        std::construct_at(
+          this->value_address(index), std::forward<Args>(args)...);
+#else
+        try {
+          std::construct_at(
+            this->value_address(index), std::forward<Args>(args)...);
+        } catch (...) {
+          this->abandon_insert(index);
+          throw;
+        }
+#endif
+      }
+      return { this->iterator_at(index), inserted };
+    }
+
+    std::pair<iterator, bool> insert(value_type const &value)
+    {
+      return try_emplace(value.first, value.second);
+    }
+
+    template<typename M>
+    std::pair<iterator, bool> insert_or_assign(W const &key, M &&value)
+    {
+      auto result = try_emplace(key, std::forward<M>(value));
+      if (!result.second) { (*result.first).second = std::forward<M>(value); }
+      return result;
+    }
+
+    V &operator[](W const &key) { return (*try_emplace(key).first).second; }
+
+    template<typename Q> V &at(Q const &key)
+    {
+      auto const it = this->find(key);
+      if (it == this->end()) {
+        details::raise<std::out_of_range>("pointer_map::at");
+      }
+      return (*it).second;
+    }
+
+    template<typename Q> V const &at(Q const &key) const
+    {
+      auto const it = this->find(key);
+      if (it == this->end()) {
+        details::raise<std::out_of_range>("pointer_map::at");
+      }
+      return (*it).second;
+    }
+  };
+
+  MP_END_EXPORT
+}// namespace pointers
+}// namespace marcpawl
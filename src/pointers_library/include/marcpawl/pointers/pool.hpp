@@ -0,0 +1,317 @@
+#pragma once
+
+#include "marcpawl/pointers/core.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace marcpawl {
+namespace pointers {
+  MP_BEGIN_EXPORT
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  // size_class_pool
+  //
+  // Process wide object pool whose objects are handed out as
+  // owner<strict_not_null<T *>>, so that callers never test the result for
+  // null and the pool does not pay for the check of the strict_not_null
+  // constructor either:
+  //
+  //   auto node = size_class_pool<>::acquire<Node>(42);
+  //   node->value = 7;
+  //   size_class_pool<>::release(std::move(node));
+  //
+  // Running out of memory is reported apart from the pointer: acquire()
+  // throws std::bad_alloc, or terminates with MP_NO_EXCEPTIONS,
+  // try_acquire() returns std::nullopt.
+  //
+  // Objects are rounded up to a size class, a power of two from 16 to 1024
+  // bytes, and are at most 16 byte aligned.  Each thread keeps a free list
+  // per size class and only goes to the shared lists, under a lock, to move
+  // a batch of objects in or out.  Memory is taken from the system in
+  // slabs, and is only given back when the process exits.
+  //
+  // Tag selects an independent pool, e.g. one per subsystem, each with its
+  // own capacity.
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename Tag = void> class size_class_pool
+  {
+  public:
+    static constexpr std::size_t min_object_size = 16;
+    static constexpr std::size_t max_object_size = 1024;
+    static constexpr std::size_t size_classes = 7;
+    static constexpr std::size_t slab_size = 64 * 1024;
+    // Objects moved between a thread and the shared lists at once.
+    static constexpr std::size_t batch_size = 32;
+
+    template<typename T> using handle = owner<strict_not_null<T *>>;
+
+    size_class_pool() = delete;
+
+    template<typename T, typename... Args>
+    [[nodiscard]] static handle<T> acquire(Args &&...args)
+    {
+      void *const memory = allocate(size_class<T>());
+      if (memory == nullptr) {
+        details::raise<std::bad_alloc>("size_class_pool exhausted");
+      }
+      return construct<T>(memory, std::forward<Args>(args)...);
+    }
+
+    template<typename T, typename... Args>
+    [[nodiscard]] static std::optional<handle<T>> try_acquire(Args &&...args)
+    {
+      void *const memory = allocate(size_class<T>());
+      if (memory == nullptr) { return std::nullopt; }
+      return construct<T>(memory, std::forward<Args>(args)...);
+    }
+
+    // Destroys the object and gives its memory back to the pool.
+    template<typename T> static void release(handle<T> object) noexcept
+    {
+      T *const ptr = object.get().get();
+      end_borrows(ptr);
+      std::destroy_at(ptr);
+      deallocate(ptr, size_class<T>());
+    }
+
+    // Limits the memory taken from the system, in bytes, rounded down to
+    // whole slabs.  Memory already taken is kept.
+    static void set_capacity(std::size_t bytes) noexcept
+    {
+      shared().capacity.store(bytes, std::memory_order_relaxed);
+    }
+
+    // Memory taken from the system, in bytes.
+    [[nodiscard]] static std::size_t reserved() noexcept
+    {
+      return shared().reserved.load(std::memory_order_relaxed);
+    }
+
+  private:
+    struct free_object
+    {
+      free_object *next;
+    };
+
+    struct slab
+    {
+      slab *next;
+    };
+
+    // Objects start after the slab header, at the alignment of the pool.
+    static constexpr std::size_t slab_header = min_object_size;
+    static_assert(sizeof(slab) <= slab_header);
+
+    struct shared_list
+    {
+      std::mutex mutex;
+      free_object *head = nullptr;
+    };
+
+    struct shared_state
+    {
+      std::array<shared_list, size_classes> lists;
+      std::mutex slabs_mutex;
+      slab *slabs = nullptr;
+      std::atomic<std::size_t> capacity{
+        std::numeric_limits<std::size_t>::max()
+      };
+      std::atomic<std::size_t> reserved{ 0 };
+
+      ~shared_state()
+      {
+        while (slabs != nullptr) {
+          slab *const next = slabs->next;
+          ::operator delete(slabs);
+          slabs = next;
+        }
+      }
+    };
+
+    struct thread_cache
+    {
+      std::array<free_object *, size_classes> heads{};
+      std::array<std::size_t, size_classes> counts{};
+
+      ~thread_cache()
+      {
+        for (std::size_t c = 0; c < size_classes; ++c) {
+          give_back(*this, c, counts[c]);
+        }
+      }
+    };
+
+    template<typename T> static constexpr std::size_t size_class() noexcept
+    {
+      static_assert(sizeof(T) <= max_object_size,
+        "size_class_pool: object larger than the largest size class");
+      static_assert(alignof(T) <= min_object_size,
+        "size_class_pool: object more aligned than the pool");
+      // The smallest class that holds T.
+      std::size_t size_class = 0;
+      while (object_size(size_class) < sizeof(T)) { ++size_class; }
+      return size_class;
+    }
+
+    static constexpr std::size_t object_size(std::size_t size_class) noexcept
+    {
+      return min_object_size << size_class;
+    }
+
+    template<typename T, typename... Args>
+    static handle<T> construct(void *memory, Args &&...args)
+    {
+      T *ptr = nullptr;
+#if defined(MP_NO_EXCEPTIONS)
+      ptr = ::new (memory) T(std::forward<Args>(args)...);
+#else
+      try {
+        ptr = ::new (memory) T(std::forward<Args>(args)...);
+      } catch (...) {
+        deallocate(memory, size_class<T>());
+        throw;
+      }
+#endif
+      return handle<T>(strict_not_null<T *>(assume_not_null, ptr));
+    }
+
+    static shared_state &shared() noexcept
+    {
+      static shared_state state;
+      return state;
+    }
+
+    static thread_cache &cache() noexcept
+    {
+      thread_local thread_cache local;
+      return local;
+    }
+
+    // nullptr when the pool is exhausted.
+    static void *allocate(std::size_t size_class) noexcept
+    {
+      thread_cache &local = cache();
+      if (local.heads[size_class] == nullptr && !refill(local, size_class)) {
+        return nullptr;
+      }
+      free_object *const object = local.heads[size_class];
+      local.heads[size_class] = object->next;
+      --local.counts[size_class];
+      return object;
+    }
+
+    static void deallocate(void *memory, std::size_t size_class) noexcept
+    {
+      thread_cache &local = cache();
+      auto *const object =
+        ::new (memory) free_object{ local.heads[size_class] };
+      local.heads[size_class] = object;
+      if (++local.counts[size_class] > 2 * batch_size) {
+        give_back(local, size_class, batch_size);
+      }
+    }
+
+    // Moves up to a batch from the shared list to the thread, or a new slab
+    // when the shared list is empty.
+    static bool refill(thread_cache &local, std::size_t size_class) noexcept
+    {
+      shared_list &list = shared().lists[size_class];
+      {
+        std::lock_guard<std::mutex> const lock(list.mutex);
+        std::size_t count = 0;
+        while (list.head != nullptr && count < batch_size) {
+          free_object *const object = list.head;
+          list.head = object->next;
+          object->next = local.heads[size_class];
+          local.heads[size_class] = object;
+          ++count;
+        }
+        local.counts[size_class] += count;
+        if (count != 0) { return true; }
+      }
+      return carve(local, size_class);
+    }
+
+    static bool carve(thread_cache &local, std::size_t size_class) noexcept
+    {
+      shared_state &state = shared();
+      std::size_t const capacity =
+        state.capacity.load(std::memory_order_relaxed);
+      std::size_t reserved = state.reserved.load(std::memory_order_relaxed);
+      do {
+        if (reserved > capacity || capacity - reserved < slab_size) {
+          return false;
+        }
+      } while (!state.reserved.compare_exchange_weak(
+        reserved, reserved + slab_size, std::memory_order_relaxed));
+
+      void *const memory = ::operator new(slab_size, std::nothrow);
+      if (memory == nullptr) {
+        state.reserved.fetch_sub(slab_size, std::memory_order_relaxed);
+        return false;
+      }
+      auto *const new_slab = ::new (memory) slab{ nullptr };
+      {
+        std::lock_guard<std::mutex> const lock(state.slabs_mutex);
+        new_slab->next = state.slabs;
+        state.slabs = new_slab;
+      }
+
+      // A batch for the thread, the rest of the slab for the shared list.
+      auto *const bytes = static_cast<std::byte *>(memory);
+      std::size_t const size = object_size(size_class);
+      free_object *rest = nullptr;
+      free_object *rest_last = nullptr;
+      std::size_t count = 0;
+      for (std::size_t offset = slab_header; offset + size <= slab_size;
+           offset += size, ++count) {
+        if (count < batch_size) {
+          local.heads[size_class] =
+            ::new (bytes + offset) free_object{ local.heads[size_class] };
+          ++local.counts[size_class];
+        } else {
+          rest = ::new (bytes + offset) free_object{ rest };
+          if (rest_last == nullptr) { rest_last = rest; }
+        }
+      }
+      if (rest != nullptr) {
+        shared_list &list = state.lists[size_class];
+        std::lock_guard<std::mutex> const lock(list.mutex);
+        rest_last->next = list.head;
+        list.head = rest;
+      }
+      return true;
+    }
+
+    // Moves count objects from the thread to the shared list.
+    static void give_back(thread_cache &local,
+      std::size_t size_class,
+      std::size_t count) noexcept
+    {
+      if (count == 0) { return; }
+      free_object *const first = local.heads[size_class];
+      free_object *last = first;
+      for (std::size_t i = 1; i < count; ++i) { last = last->next; }
+      local.heads[size_class] = last->next;
+      local.counts[size_class] -= count;
+
+      shared_list &list = shared().lists[size_class];
+      std::lock_guard<std::mutex> const lock(list.mutex);
+      last->next = list.head;
+      list.head = first;
+    }
+  };
+
+  MP_END_EXPORT
+}// namespace pointers
+}// namespace marcpawl
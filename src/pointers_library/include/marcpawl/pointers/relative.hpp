@@ -0,0 +1,315 @@
+#pragma once
+
+#include "marcpawl/pointers/core.hpp"
+
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace marcpawl {
+namespace pointers {
+  MP_BEGIN_EXPORT
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  // Relative pointers
+  //
+  // Pointers stored as a distance rather than as an address, to save space
+  // and to survive the memory they live in being moved as a whole.  They
+  // satisfy details::Pointer, so that maybe_null, strict_not_null and
+  // borrower wrap them like a raw pointer:
+  //
+  //   maybe_null<compressed_ptr<Node>> next;
+  //
+  // - offset_ptr<T, Base> is a 32 bit offset from an arena whose address
+  //   is given by Base::base().
+  // - basic_self_relative<T, Offset> is an offset from the address of the
+  //   pointer itself, compressed_ptr<T> is the 32 bit one and
+  //   self_relative<T> the full width one.
+  //
+  // Encoding a pointer that is too far away throws std::out_of_range.
+  // They print the address they point to, unless MP_NO_IOSTREAMS is
+  // defined.  Only <iosfwd> is included: the stream they print to brings
+  // the rest.
+  //
+  // A self relative pointer only reaches its target from where it is
+  // stored, so a copy of it on the stack may not encode.  maybe_null,
+  // strict_not_null or borrower of a self relative pointer kept on the heap
+  // can therefore not be passed by value, copied into a local, or built on
+  // the stack and then assigned.  maybe_null hands the raw pointer it
+  // decodes to, strict_not_null<Node *>, to the handlers of visit and in
+  // the results of its conversions, and a handler taking
+  // strict_not_null<compressed_ptr<Node>> does not compile.  Rebind in
+  // place instead, or build the node in place:
+  //
+  //   node->next = other;                              // maybe_null, borrower
+  //   node->first.reset(other);                        // strict_not_null
+  //   node->next = maybe_null<compressed_ptr<Node>>{ other };  // may throw
+  ////////////////////////////////////////////////////////////////////////////
+
+  template<typename Base>
+  concept ArenaBase = requires {
+    { Base::base() } -> std::convertible_to<void const *>;
+  };
+
+
+  ////////////////////////////////////////////////////////////////////////////
+  // offset_ptr
+  //
+  // Stores the byte offset from Base::base() plus one, so that zero is the
+  // null pointer and zero filled memory holds null pointers.  Reaches the
+  // first 4 GiB of the arena.  Trivially copyable.
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename T, ArenaBase Base> class offset_ptr
+  {
+  public:
+    using element_type = T;
+    using offset_type = std::uint32_t;
+
+    constexpr offset_ptr() noexcept = default;
+    constexpr offset_ptr(std::nullptr_t) noexcept {}
+    offset_ptr(T *ptr) : offset_(encode(ptr)) {}
+
+    template<typename U>
+      requires std::is_convertible_v<U *, T *>
+    offset_ptr(offset_ptr<U, Base> const &other) : offset_ptr(other.get())
+    {}
+
+    [[nodiscard]] T *get() const noexcept
+    {
+      if (offset_ == 0) { return nullptr; }
+      return target();
+    }
+
+    // Not null, as for T *, so the target is formed without testing.
+    T &operator*() const noexcept { return *target(); }
+    T *operator->() const noexcept { return target(); }
+    explicit operator bool() const noexcept { return offset_ != 0; }
+
+    // The stored value, zero for null.
+    [[nodiscard]] offset_type offset() const noexcept { return offset_; }
+
+    friend bool operator==(offset_ptr const &lhs,
+      offset_ptr const &rhs) = default;
+    friend bool operator==(offset_ptr const &lhs, std::nullptr_t) noexcept
+    {
+      return lhs.offset_ == 0;
+    }
+    friend bool operator==(offset_ptr const &lhs, void const *rhs) noexcept
+    {
+      return lhs.get() == rhs;
+    }
+    friend auto operator<=>(offset_ptr const &lhs,
+      offset_ptr const &rhs) noexcept
+    {
+      return std::compare_three_way{}(lhs.get(), rhs.get());
+    }
+
+#if !defined(MP_NO_IOSTREAMS)
+    template<typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits> &operator<<(
+      std::basic_ostream<CharT, Traits> &os, offset_ptr const &val)
+    {
+      os << val.get();
+      return os;
+    }
+#endif
+
+  private:
+    T *target() const noexcept
+    {
+      return reinterpret_cast<T *>(base() + offset_ - 1);
+    }
+
+    static std::uintptr_t base() noexcept
+    {
+      return reinterpret_cast<std::uintptr_t>(
+        static_cast<void const *>(Base::base()));
+    }
+
+    static offset_type encode(T *ptr)
+    {
+      if (ptr == nullptr) { return 0; }
+      auto const address = reinterpret_cast<std::uintptr_t>(ptr);
+      if (address < base()
+          || address - base() >= std::numeric_limits<offset_type>::max()) {
+        details::raise<std::out_of_range>(
+          "offset_ptr: pointer outside of the arena");
+      }
+      return static_cast<offset_type>(address - base() + 1);
+    }
+
+    offset_type offset_ = 0;
+  };
+
+
+  ////////////////////////////////////////////////////////////////////////////
+  // basic_self_relative
+  //
+  // Stores the byte distance from the pointer to its target, so that a
+  // block of memory holding both can be copied or mapped at another address
+  // and stay valid.  Copying a single pointer re-encodes it for its new
+  // address, which is why it is not trivially copyable.
+  //
+  // A distance of one is never a real one since T is at least 2 byte
+  // aligned, and stands for null, so that a pointer to the object that
+  // holds it is not mistaken for null.
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename T, std::signed_integral Offset> class basic_self_relative
+  {
+  public:
+    using element_type = T;
+    using offset_type = Offset;
+
+    basic_self_relative() noexcept = default;
+    basic_self_relative(std::nullptr_t) noexcept {}
+    basic_self_relative(T *ptr) : offset_(encode(ptr)) {}
+
+    basic_self_relative(basic_self_relative const &other)
+      : offset_(encode(other.get()))
+    {}
+
+    template<typename U>
+      requires std::is_convertible_v<U *, T *>
+    basic_self_relative(basic_self_relative<U, Offset> const &other)
+      : offset_(encode(other.get()))
+    {}
+
+    basic_self_relative &operator=(basic_self_relative const &other)
+    {
+      offset_ = encode(other.get());
+      return *this;
+    }
+
+    basic_self_relative &operator=(T *ptr)
+    {
+      offset_ = encode(ptr);
+      return *this;
+    }
+
+    basic_self_relative &operator=(std::nullptr_t) noexcept
+    {
+      offset_ = null;
+      return *this;
+    }
+
+    ~basic_self_relative() = default;
+
+    [[nodiscard]] T *get() const noexcept
+    {
+      if (offset_ == null) { return nullptr; }
+      return target();
+    }
+
+    // Not null, as for T *, so the target is formed without testing.
+    T &operator*() const noexcept { return *target(); }
+    T *operator->() const noexcept { return target(); }
+    explicit operator bool() const noexcept { return offset_ != null; }
+
+    friend bool operator==(basic_self_relative const &lhs,
+      basic_self_relative const &rhs) noexcept
+    {
+      return lhs.get() == rhs.get();
+    }
+    friend bool operator==(basic_self_relative const &lhs,
+      std::nullptr_t) noexcept
+    {
+      return lhs.offset_ == null;
+    }
+    friend bool operator==(basic_self_relative const &lhs,
+      void const *rhs) noexcept
+    {
+      return lhs.get() == rhs;
+    }
+    friend auto operator<=>(basic_self_relative const &lhs,
+      basic_self_relative const &rhs) noexcept
+    {
+      return std::compare_three_way{}(lhs.get(), rhs.get());
+    }
+
+#if !defined(MP_NO_IOSTREAMS)
+    template<typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits> &operator<<(
+      std::basic_ostream<CharT, Traits> &os, basic_self_relative const &val)
+    {
+      os << val.get();
+      return os;
+    }
+#endif
+
+  private:
+    static constexpr Offset null = 1;
+
+    [[nodiscard]] std::uintptr_t self() const noexcept
+    {
+      return reinterpret_cast<std::uintptr_t>(this);
+    }
+
+    T *target() const noexcept
+    {
+      return reinterpret_cast<T *>(
+        self() + static_cast<std::uintptr_t>(offset_));
+    }
+
+    Offset encode(T *ptr) const
+    {
+      static_assert(alignof(T) > 1,
+        "basic_self_relative: an offset of 1 is reserved for null");
+      if (ptr == nullptr) { return null; }
+      auto const distance = static_cast<std::intptr_t>(
+        reinterpret_cast<std::uintptr_t>(ptr) - self());
+      if constexpr (sizeof(Offset) < sizeof(std::intptr_t)) {
+        if (distance < std::numeric_limits<Offset>::min()
+            || distance > std::numeric_limits<Offset>::max()) {
+          details::raise<std::out_of_range>(
+            "basic_self_relative: pointer too far for the offset");
+        }
+      }
+      return static_cast<Offset>(distance);
+    }
+
+    Offset offset_ = null;
+  };
+
+  // 32 bit self relative pointer, reaches 2 GiB either way.
+  template<typename T>
+  using compressed_ptr = basic_self_relative<T, std::int32_t>;
+
+  // Full width self relative pointer, for structures written to a file or
+  // to shared memory and mapped back at any address:
+  //
+  //   struct node { maybe_null<self_relative<node>> left, right; };
+  //
+  // Nodes built in one region can be traversed through another mapping of
+  // the same bytes without fixing up any pointer.
+  template<typename T>
+  using self_relative = basic_self_relative<T, std::ptrdiff_t>;
+
+  MP_END_EXPORT
+}// namespace pointers
+}// namespace marcpawl
+
+template<typename T, typename Base>
+struct std::hash<marcpawl::pointers::offset_ptr<T, Base>>
+{
+  std::size_t operator()(
+    marcpawl::pointers::offset_ptr<T, Base> const &p) const noexcept
+  {
+    return std::hash<T *>{}(p.get());
+  }
+};
+
+template<typename T, typename Offset>
+struct std::hash<marcpawl::pointers::basic_self_relative<T, Offset>>
+{
+  std::size_t operator()(
+    marcpawl::pointers::basic_self_relative<T, Offset> const &p) const noexcept
+  {
+    return std::hash<T *>{}(p.get());
+  }
+};
@@ -0,0 +1,208 @@
+#pragma once
+
+#include "marcpawl/pointers/core.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <source_location>
+#include <stdexcept>
+#include <type_traits>
+
+namespace marcpawl {
+namespace pointers {
+  namespace details {
+    template<typename W> struct is_maybe_null : std::false_type
+    {
+    };
+
+    template<typename T> struct is_maybe_null<maybe_null<T>> : std::true_type
+    {
+    };
+
+    struct no_borrow_stamp
+    {
+    };
+
+    // Low bits of a pointer held by W that are always zero, because of the
+    // alignment of the pointee.
+    template<WrappedRawPointer W>
+    inline constexpr std::size_t alignment_bits_v = static_cast<std::size_t>(
+      std::countr_zero(alignof(std::remove_pointer_t<decltype(W::ptr_)>)));
+  }// namespace details
+
+  MP_BEGIN_EXPORT
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  // tagged
+  //
+  // A wrapped pointer and a small tag packed into one word, the tag is kept
+  // in the low bits of the pointer that are always zero because of the
+  // alignment of the pointee.  By default every such bit is used, e.g. 3
+  // bits for an 8 byte aligned node.
+  //
+  //   tagged<borrower<Node *>, 1> edge{ make_borrower(node), visited };
+  //
+  // Has zero size overhead over T*, where a pointer and a flag side by side
+  // take two words once padded.
+  //
+  // The wrapper is only ever given back without its tag, so the null safety
+  // of W is kept: a tagged<maybe_null<T *>> has to be visited, and a
+  // tagged<strict_not_null<T *>> is never null.
+  ////////////////////////////////////////////////////////////////////////////
+  template<details::WrappedRawPointer W,
+    std::size_t Bits = details::alignment_bits_v<W>>
+  class tagged
+  {
+    static_assert(Bits <= details::alignment_bits_v<W>,
+      "tagged: more tag bits than the alignment of the pointee leaves free");
+
+    static constexpr bool is_maybe_null = details::is_maybe_null<W>::value;
+    static constexpr bool is_borrow_checked =
+      details::is_borrow_checked<W>::value;
+
+  public:
+    using wrapper_type = W;
+    using pointer = decltype(W::ptr_);
+    using tag_type = std::uintptr_t;
+
+    static constexpr std::size_t tag_bits = Bits;
+    static constexpr tag_type tag_mask = (tag_type{ 1 } << Bits) - 1;
+
+    tagged()
+      requires std::is_default_constructible_v<W>
+      : tagged(W{})
+    {}
+
+    explicit tagged(W const &ptr, tag_type tag = 0)
+      : bits_(reinterpret_cast<std::uintptr_t>(ptr.ptr_) | checked(tag))
+    {
+      keep_stamp(ptr);
+    }
+
+    // The wrapper, without the tag.  It is given back as it was given, a
+    // strict_not_null is not tested again and a borrower keeps the stamp
+    // of its object, so that it still sees the end of its lifetime.
+    [[nodiscard]] W untagged() const
+    {
+      if constexpr (details::is_strict_not_null<W>::value) {
+        return W{ assume_not_null, raw() };
+      }
+#if defined(MP_BORROW_CHECKS)
+      else if constexpr (is_borrow_checked) {
+        return details::borrow_access::make<W>(raw(), stamp_);
+      }
+#endif
+      else {
+        return W{ raw() };
+      }
+    }
+
+    [[nodiscard]] tag_type tag() const noexcept { return bits_ & tag_mask; }
+
+    void set_tag(tag_type tag) { bits_ = (bits_ & ~tag_mask) | checked(tag); }
+
+    // Replaces the pointer, keeping the tag.
+    void assign(W const &ptr)
+    {
+      bits_ = reinterpret_cast<std::uintptr_t>(ptr.ptr_) | tag();
+      keep_stamp(ptr);
+    }
+
+    // The pointer with the tag bits masked off.
+    [[nodiscard]] pointer get() const noexcept
+      requires(!is_maybe_null)
+    {
+      return raw();
+    }
+
+    [[deprecated]] [[nodiscard]] pointer get() const noexcept
+      requires is_maybe_null
+    {
+      return raw();
+    }
+
+    // A borrower is dereferenced through W, which sees the end of the
+    // lifetime of its object, see MP_BORROW_CHECKS.
+    decltype(auto) operator->() const
+      requires(!is_maybe_null)
+    {
+      if constexpr (is_borrow_checked) {
+        return untagged().operator->();
+      } else {
+        return raw();
+      }
+    }
+
+    decltype(auto) operator*() const
+      requires(!is_maybe_null)
+    {
+      if constexpr (is_borrow_checked) {
+        return *untagged();
+      } else {
+        return *raw();
+      }
+    }
+
+    template<null_likelihood Likelihood = null_likelihood::unknown>
+    [[nodiscard]] auto visit(nullptr_handler auto handle_nullptr,
+      not_null_handler<pointer> auto handle_not_null,
+      std::source_location const &location =
+        std::source_location::current()) const
+      requires is_maybe_null
+    {
+      return untagged().template visit<Likelihood>(
+        handle_nullptr, handle_not_null, location);
+    }
+
+    template<null_likelihood Likelihood = null_likelihood::unknown>
+    [[nodiscard]] auto as_optional_not_null(
+      std::source_location const &location =
+        std::source_location::current()) const
+      requires is_maybe_null
+    {
+      return untagged().template as_optional_not_null<Likelihood>(location);
+    }
+
+    // Equal when both the pointer and the tag are.
+    friend bool operator==(tagged const &lhs, tagged const &rhs) noexcept
+    {
+      return lhs.bits_ == rhs.bits_;
+    }
+
+  private:
+    static tag_type checked(tag_type tag)
+    {
+      if (tag > tag_mask) {
+        details::raise<std::out_of_range>(
+          "tag does not fit in the alignment bits");
+      }
+      return tag;
+    }
+
+    [[nodiscard]] pointer raw() const noexcept
+    {
+      return reinterpret_cast<pointer>(bits_ & ~tag_mask);
+    }
+
+    void keep_stamp([[maybe_unused]] W const &ptr) noexcept
+    {
+#if defined(MP_BORROW_CHECKS)
+      if constexpr (is_borrow_checked) {
+        stamp_ = details::borrow_access::stamp(ptr);
+      }
+#endif
+    }
+
+    std::uintptr_t bits_;
+#if defined(MP_BORROW_CHECKS)
+    [[no_unique_address]] std::conditional_t<is_borrow_checked,
+      details::borrow_table::stamp_type,
+      details::no_borrow_stamp> stamp_{};
+#endif
+  };
+
+  MP_END_EXPORT
+}// namespace pointers
+}// namespace marcpawl
@@ -0,0 +1,77 @@
+// The marcpawl.pointers module, everything of the headers of
+// marcpawl/pointers:
+//
+//   import marcpawl.pointers;
+//
+//   marcpawl::pointers::maybe_null<Node *> next;
+//
+// The headers are part of the module, and export what they have between
+// MP_BEGIN_EXPORT and MP_END_EXPORT.  The standard headers they include are
+// included first, in the global module fragment, so that they stay out of
+// the module.
+//
+// The module is built once, with the MP_ macros of the pointers_module
+// target, e.g. MP_NULL_POLICY.  The macros are not exported: a translation
+// unit that needs them, or MP_BORROW_CHECKS or the call site counters,
+// includes the headers instead.
+
+module;
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cinttypes>
+#include <compare>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <iosfwd>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <ostream>
+#include <source_location>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// The intrinsics of batch.hpp and pointer_set.hpp.
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+export module marcpawl.pointers;
+
+#define MP_MODULE
+
+#include "marcpawl/pointers/arena.hpp"
+#include "marcpawl/pointers/atomic.hpp"
+#include "marcpawl/pointers/batch.hpp"
+#include "marcpawl/pointers/epoch.hpp"
+#include "marcpawl/pointers/hazard.hpp"
+#include "marcpawl/pointers/intrusive.hpp"
+#include "marcpawl/pointers/io.hpp"
+#include "marcpawl/pointers/pointer_set.hpp"
+#include "marcpawl/pointers/pool.hpp"
+#include "marcpawl/pointers/relative.hpp"
+#include "marcpawl/pointers/tagged.hpp"
@@ -0,0 +1,96 @@
+#include "marcpawl/pointers/arena.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mp = marcpawl::pointers;
+
+// NOLINTBEGIN (cppcoreguidelines-avoid-magic-numbers)
+
+namespace {
+struct node
+{
+  int value = 0;
+  mp::borrower<node *> next{ nullptr };
+};
+
+struct alignas(64) wide
+{
+  std::uint8_t byte = 0;
+};
+
+// Records the order in which it is destroyed.
+struct tracked
+{
+  std::vector<int> *log;
+  int id;
+  ~tracked() { log->push_back(id); }
+};
+}// namespace
+
+TEST_CASE("arena make", "[arena]")
+{
+  mp::arena arena;
+  mp::owner<node *> const first = arena.make<node>(1);
+  mp::owner<node *> const second =
+    arena.make<node>(2, first.as_borrower());
+  REQUIRE(first->value == 1);
+  REQUIRE(second->value == 2);
+  REQUIRE(second->next == first.as_borrower());
+  REQUIRE(second->next->value == 1);
+
+  mp::owner<wide *> const aligned = arena.make<wide>();
+  REQUIRE(reinterpret_cast<std::uintptr_t>(aligned.get()) % 64 == 0);
+}
+
+TEST_CASE("arena grows", "[arena]")
+{
+  mp::arena arena(64);
+  std::vector<mp::borrower<node *>> nodes;
+  for (int i = 0; i < 1000; ++i) {
+    nodes.push_back(arena.make<node>(i).as_borrower());
+  }
+  int expected = 0;
+  for (auto const &n : nodes) { REQUIRE(n->value == expected++); }
+  REQUIRE(arena.capacity() >= 1000 * sizeof(node));
+
+  // Larger than any block so far.
+  auto *const large = static_cast<std::byte *>(arena.allocate(1 << 20, 16));
+  REQUIRE(large != nullptr);
+  large[(1 << 20) - 1] = std::byte{ 1 };
+}
+
+TEST_CASE("arena release", "[arena]")
+{
+  std::vector<int> log;
+  mp::arena arena(64);
+  for (int i = 0; i < 100; ++i) { (void)arena.make<tracked>(&log, i); }
+  auto const strings = arena.make<std::string>(std::size_t{ 200 }, 'x');
+  REQUIRE(strings->size() == 200);
+
+  arena.release();
+  REQUIRE(log.size() == 100);
+  REQUIRE(log.front() == 99);
+  REQUIRE(log.back() == 0);
+
+  // The largest block is kept, so the same work does not grow the arena.
+  auto const capacity = arena.capacity();
+  for (int i = 0; i < 100; ++i) { (void)arena.make<node>(i); }
+  REQUIRE(arena.capacity() == capacity);
+}
+
+TEST_CASE("arena destruction", "[arena]")
+{
+  std::vector<int> log;
+  {
+    mp::arena arena;
+    (void)arena.make<tracked>(&log, 1);
+    (void)arena.make<tracked>(&log, 2);
+  }
+  REQUIRE(log == std::vector<int>{ 2, 1 });
+}
+
+// NOLINTEND
@@ -0,0 +1,136 @@
+#include "marcpawl/pointers/atomic.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace mp = marcpawl::pointers;
+
+// NOLINTBEGIN (cppcoreguidelines-avoid-magic-numbers)
+
+TEST_CASE("atomic layout", "[atomic]")
+{
+  STATIC_REQUIRE(sizeof(mp::atomic_maybe_null<int *>) == sizeof(int *));
+  STATIC_REQUIRE(sizeof(mp::atomic_strict_not_null<int *>) == sizeof(int *));
+  STATIC_REQUIRE(mp::atomic_strict_not_null<int *>::is_always_lock_free);
+  STATIC_REQUIRE(
+    !std::is_default_constructible_v<mp::atomic_strict_not_null<int *>>);
+  STATIC_REQUIRE(!std::is_copy_constructible_v<mp::atomic_maybe_null<int *>>);
+
+  STATIC_REQUIRE(
+    alignof(mp::padded_atomic_maybe_null<int *>) == mp::cache_line_size);
+  STATIC_REQUIRE(
+    sizeof(mp::padded_atomic_strict_not_null<int *>) == mp::cache_line_size);
+  std::array<mp::padded_atomic_maybe_null<int *>, 2> padded{};
+  REQUIRE(reinterpret_cast<char *>(&padded[1])
+            - reinterpret_cast<char *>(&padded[0])
+          == mp::cache_line_size);
+}
+
+TEST_CASE("atomic_maybe_null", "[atomic]")
+{
+  int a = 1;
+  int b = 2;
+  mp::atomic_maybe_null<int *> shared;
+  REQUIRE(shared.is_lock_free());
+  REQUIRE(shared.load() == nullptr);
+
+  shared.store(mp::maybe_null<int *>(&a));
+  REQUIRE(shared.load() == &a);
+  REQUIRE(shared.exchange(mp::maybe_null<int *>(nullptr)) == &a);
+  REQUIRE(shared.load(std::memory_order_acquire) == nullptr);
+
+  mp::maybe_null<int *> expected(&b);
+  REQUIRE(!shared.compare_exchange_strong(expected, mp::maybe_null<int *>(&a)));
+  REQUIRE(expected == nullptr);
+  REQUIRE(shared.compare_exchange_strong(expected, mp::maybe_null<int *>(&b)));
+  REQUIRE(shared.load() == &b);
+  expected = mp::maybe_null<int *>(&b);
+  while (!shared.compare_exchange_weak(expected,
+    mp::maybe_null<int *>(&a),
+    std::memory_order_acq_rel,
+    std::memory_order_acquire)) {}
+  REQUIRE(shared.load() == &a);
+}
+
+TEST_CASE("atomic_strict_not_null", "[atomic]")
+{
+  int a = 1;
+  int b = 2;
+  mp::atomic_strict_not_null<int *> shared{ mp::strict_not_null(&a) };
+  mp::strict_not_null<int *> const loaded = shared.load();
+  REQUIRE(*loaded == 1);
+
+  REQUIRE(shared.exchange(mp::strict_not_null(&b)).get() == &a);
+  REQUIRE(shared.load().get() == &b);
+
+  mp::strict_not_null<int *> expected(&a);
+  REQUIRE(!shared.compare_exchange_strong(expected, mp::strict_not_null(&a)));
+  REQUIRE(expected.get() == &b);
+  REQUIRE(shared.compare_exchange_strong(expected, mp::strict_not_null(&a)));
+  REQUIRE(shared.load().get() == &a);
+
+  shared.store(mp::strict_not_null(&b), std::memory_order_release);
+  REQUIRE(*shared.load(std::memory_order_acquire) == 2);
+}
+
+TEST_CASE("atomic_strict_not_null threads", "[atomic]")
+{
+  constexpr std::size_t readers = 3;
+  constexpr int updates = 20000;
+  std::array<int, 4> values{ 0, 1, 2, 3 };
+  mp::atomic_strict_not_null<int *> shared{ mp::strict_not_null(&values[0]) };
+  std::atomic<bool> done{ false };
+  std::array<bool, readers> ok{};
+
+  std::vector<std::thread> threads;
+  for (std::size_t r = 0; r < readers; ++r) {
+    threads.emplace_back([&, r] {
+      bool all = true;
+      while (!done.load(std::memory_order_acquire)) {
+        int *const p = shared.load(std::memory_order_acquire).get();
+        all = all && p >= values.data() && p < values.data() + values.size();
+      }
+      ok[r] = all;
+    });
+  }
+  for (int i = 0; i < updates; ++i) {
+    auto expected = shared.load();
+    while (!shared.compare_exchange_weak(expected,
+      mp::strict_not_null(
+        &values[static_cast<std::size_t>(*expected + 1) % values.size()]))) {}
+  }
+  done.store(true, std::memory_order_release);
+  for (auto &thread : threads) { thread.join(); }
+  for (bool const reader_ok : ok) { REQUIRE(reader_ok); }
+  REQUIRE(*shared.load() == updates % 4);
+}
+
+TEST_CASE("atomic wait and notify", "[atomic]")
+{
+  int a = 1;
+  int b = 2;
+  mp::atomic_strict_not_null<int *> shared{ mp::strict_not_null(&a) };
+  bool woken_with_b = false;
+  std::thread waiter([&] {
+    shared.wait(mp::strict_not_null(&a));
+    woken_with_b = shared.load().get() == &b;
+  });
+  shared.store(mp::strict_not_null(&b));
+  shared.notify_one();
+  waiter.join();
+  REQUIRE(woken_with_b);
+
+  mp::atomic_maybe_null<int *> maybe;
+  std::thread maybe_waiter([&] { maybe.wait(mp::maybe_null<int *>(nullptr)); });
+  maybe.store(mp::maybe_null<int *>(&a));
+  maybe.notify_all();
+  maybe_waiter.join();
+  REQUIRE(maybe.load() == &a);
+}
+
+// NOLINTEND
@@ -0,0 +1,100 @@
+#include "marcpawl/pointers/batch.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace mp = marcpawl::pointers;
+
+// NOLINTBEGIN (cppcoreguidelines-avoid-magic-numbers)
+
+namespace {
+// Every length and position of the null, around the vector widths.
+constexpr std::size_t max_length = 70;
+}// namespace
+
+TEST_CASE("find_null", "[batch]")
+{
+  std::vector<int> values(max_length);
+  for (std::size_t length = 0; length <= max_length; ++length) {
+    std::vector<int *> pointers;
+    for (std::size_t i = 0; i < length; ++i) { pointers.push_back(&values[i]); }
+    REQUIRE(mp::find_null(std::span(pointers)) == length);
+
+    for (std::size_t null = 0; null < length; ++null) {
+      pointers[null] = nullptr;
+      REQUIRE(mp::find_null(std::span(pointers)) == null);
+      // The first one is reported.
+      pointers.back() = nullptr;
+      REQUIRE(mp::find_null(std::span(pointers)) == null);
+      pointers[null] = &values[null];
+      pointers.back() = &values[length - 1];
+    }
+  }
+
+  int *const *const none = nullptr;
+  REQUIRE(mp::find_null(std::span(none, 0)) == 0);
+}
+
+TEST_CASE("as_not_null_span", "[batch]")
+{
+  std::array<int, 40> values{};
+  std::array<int *, 40> pointers{};
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<int>(i);
+    pointers[i] = &values[i];
+  }
+
+  SECTION("strict_not_null")
+  {
+    auto checked = mp::as_not_null_span(std::span<int *>(pointers));
+    auto const *const view =
+      std::get_if<std::span<mp::strict_not_null<int *>>>(&checked);
+    REQUIRE(view != nullptr);
+    // The same memory, not a copy.
+    REQUIRE(static_cast<void *>(view->data()) == pointers.data());
+    REQUIRE(view->size() == pointers.size());
+    int sum = 0;
+    for (mp::strict_not_null<int *> const ptr : *view) { sum += *ptr; }
+    REQUIRE(sum == 39 * 40 / 2);
+  }
+
+  SECTION("borrower")
+  {
+    STATIC_REQUIRE(
+      sizeof(mp::borrower<mp::strict_not_null<int *>>) == sizeof(int *));
+    auto checked =
+      mp::as_not_null_span<mp::borrower<mp::strict_not_null<int *>>>(
+        std::span<int *, 40>(pointers));
+    using view_type =
+      std::span<mp::borrower<mp::strict_not_null<int *>>, 40>;
+    STATIC_REQUIRE(
+      (std::is_same_v<decltype(checked), std::variant<mp::null_at, view_type>>));
+    REQUIRE(std::holds_alternative<view_type>(checked));
+    REQUIRE(*std::get<view_type>(checked)[7].get() == 7);
+  }
+
+  SECTION("null")
+  {
+    pointers[33] = nullptr;
+    pointers[35] = nullptr;
+    auto const checked = mp::as_not_null_span(std::span<int *>(pointers));
+    REQUIRE(std::holds_alternative<mp::null_at>(checked));
+    REQUIRE(std::get<mp::null_at>(checked) == mp::null_at{ 33 });
+  }
+
+  SECTION("empty")
+  {
+    auto const checked = mp::as_not_null_span(std::span<int *>());
+    auto const *const view =
+      std::get_if<std::span<mp::strict_not_null<int *>>>(&checked);
+    REQUIRE(view != nullptr);
+    REQUIRE(view->empty());
+  }
+}
+
+// NOLINTEND
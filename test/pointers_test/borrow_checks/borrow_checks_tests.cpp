@@ -0,0 +1,251 @@
+#include "marcpawl/pointers/arena.hpp"
+#include "marcpawl/pointers/epoch.hpp"
+#include "marcpawl/pointers/pointer_set.hpp"
+#include "marcpawl/pointers/pool.hpp"
+#include "marcpawl/pointers/ptr.hpp"
+#include "marcpawl/pointers/tagged.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace mp = marcpawl::pointers;
+
+// NOLINTBEGIN (cppcoreguidelines-avoid-magic-numbers)
+
+#if !defined(MP_BORROW_CHECKS)
+#error "must be built with MP_BORROW_CHECKS"
+#endif
+
+namespace {
+struct base
+{
+  int value = 1;
+};
+
+struct derived : base
+{
+};
+
+struct shape
+{
+  shape() = default;
+  shape(shape const &) = default;
+  shape &operator=(shape const &) = default;
+  virtual ~shape() = default;
+  int value = 1;
+};
+
+struct circle : shape
+{
+};
+
+struct epoch_tag;
+using domain = mp::epoch_domain<epoch_tag>;
+}// namespace
+
+TEST_CASE("borrower outliving its owner", "[borrow_checks]")
+{
+  STATIC_REQUIRE(mp::details::borrow_checks);
+
+  mp::owner<base *> owner = mp::make_owner(new base);
+  mp::borrower<base *> const view(owner);
+  mp::borrower<base *> const copy = view;
+  REQUIRE(view->value == 1);
+  REQUIRE((*copy).value == 1);
+
+  mp::delete_owned(std::move(owner));
+  REQUIRE_THROWS_AS(view->value, mp::nullptr_exception);
+  REQUIRE_THROWS_AS((*copy).value, mp::nullptr_exception);
+}
+
+TEST_CASE("borrower of a reused address", "[borrow_checks]")
+{
+  auto storage = std::make_unique<derived>();
+  mp::owner<derived *> const first(storage.get());
+  mp::borrower<derived *> const old_view = first.as_borrower();
+  mp::borrower<base *> const converted(old_view);
+  mp::end_borrows(storage.get());
+
+  // A new object at the same address is a new generation.
+  mp::owner<derived *> const second(storage.get());
+  mp::borrower<derived *> const new_view(second);
+  REQUIRE(new_view->value == 1);
+  REQUIRE_THROWS_AS(old_view->value, mp::nullptr_exception);
+  REQUIRE_THROWS_AS(converted->value, mp::nullptr_exception);
+
+  // Owned again while alive, borrowers stay valid.
+  mp::owner<derived *> const again(storage.get());
+  REQUIRE(new_view->value == 1);
+  mp::end_borrows(storage.get());
+}
+
+TEST_CASE("borrower of a converted owner", "[borrow_checks]")
+{
+  mp::owner<circle *> owned = mp::make_owner(new circle);
+  mp::owner<shape *> owner(std::move(owned));
+  mp::borrower<shape *> const view = owner.as_borrower();
+  // Made from the pointer, so the object is looked up.
+  mp::borrower<shape *> const from_pointer(owner.get());
+  REQUIRE(view->value == 1);
+  REQUIRE(from_pointer->value == 1);
+
+  mp::delete_owned(std::move(owner));
+  REQUIRE_THROWS_AS(view->value, mp::nullptr_exception);
+  REQUIRE_THROWS_AS(from_pointer->value, mp::nullptr_exception);
+}
+
+TEST_CASE("tagged borrower of a reused address", "[borrow_checks]")
+{
+  auto storage = std::make_unique<shape>();
+  mp::tagged<mp::owner<shape *>, 1> owned{ mp::make_owner(storage.get()), 1 };
+  mp::tagged<mp::borrower<shape *>, 1> const edge{
+    owned.untagged().as_borrower(), 1
+  };
+  // Taking the owner back out does not start a new lifetime.
+  mp::borrower<shape *> const view = owned.untagged().as_borrower();
+  REQUIRE(edge.untagged()->value == 1);
+  REQUIRE(view->value == 1);
+  mp::end_borrows(storage.get());
+
+  // The borrower taken out keeps the stamp of the first object.
+  mp::owner<shape *> const second(storage.get());
+  REQUIRE_THROWS_AS(edge.untagged()->value, mp::nullptr_exception);
+  REQUIRE_THROWS_AS(view->value, mp::nullptr_exception);
+  mp::end_borrows(storage.get());
+}
+
+TEST_CASE("pointer_set of owners", "[borrow_checks]")
+{
+  mp::owner<base *> owner = mp::make_owner(new base);
+  mp::borrower<base *> const view(owner);
+  mp::pointer_set<mp::owner<base *>> owners{ owner };
+  REQUIRE((*owners.begin())->value == 1);
+  REQUIRE(mp::borrower<base *>(*owners.begin())->value == 1);
+
+  base *const address = owner.get();
+  mp::delete_owned(std::move(owner));
+  // Iterating does not start a new lifetime for the deleted object.
+  for (mp::owner<base *> const &key : owners) { REQUIRE(key.get() == address); }
+  REQUIRE(mp::details::borrow_table::stamp(address).generation == 0);
+  REQUIRE_THROWS_AS(view->value, mp::nullptr_exception);
+}
+
+TEST_CASE("tagged borrower dereferenced after its owner", "[borrow_checks]")
+{
+  mp::owner<base *> owner = mp::make_owner(new base);
+  mp::tagged<mp::borrower<base *>, 1> const edge{ owner.as_borrower(), 1 };
+  REQUIRE(edge->value == 1);
+  REQUIRE((*edge).value == 1);
+
+  mp::delete_owned(std::move(owner));
+  REQUIRE_THROWS_AS(edge->value, mp::nullptr_exception);
+  REQUIRE_THROWS_AS((*edge).value, mp::nullptr_exception);
+}
+
+TEST_CASE("borrow slots are taken over once free", "[borrow_checks]")
+{
+  // Every byte is a new address, far more than the slots near them.
+  auto const storage = std::make_unique<char[]>(4096);
+  std::uint64_t const untracked = mp::borrows_untracked();
+  for (std::size_t i = 0; i < 4096; ++i) {
+    mp::owner<char *> const owner(storage.get() + i);
+    mp::borrower<char *> const view(owner);
+    REQUIRE_NOTHROW(*view);
+    mp::end_borrows(storage.get() + i);
+    REQUIRE_THROWS_AS(*view, mp::nullptr_exception);
+  }
+  REQUIRE(mp::borrows_untracked() == untracked);
+}
+
+TEST_CASE("borrow generation running out", "[borrow_checks]")
+{
+  auto storage = std::make_unique<base>();
+  std::uint64_t const retired = mp::borrow_slots_retired();
+  mp::owner<base *> const first(storage.get());
+  mp::borrower<base *> const stale(first);
+  mp::end_borrows(storage.get());
+
+  // More lifetimes than a 16 bit generation counts.
+  for (int i = 0; i < 32767; ++i) {
+    mp::owner<base *> const again(storage.get());
+    mp::end_borrows(storage.get());
+  }
+  mp::owner<base *> const last(storage.get());
+  REQUIRE(mp::borrow_slots_retired() > retired);
+  REQUIRE(mp::borrower<base *>(last)->value == 1);
+  REQUIRE_THROWS_AS(stale->value, mp::nullptr_exception);
+  mp::end_borrows(storage.get());
+}
+
+TEST_CASE("borrower without an owner is not checked", "[borrow_checks]")
+{
+  base local;
+  mp::borrower<base *> const view(&local);
+  REQUIRE(view->value == 1);
+
+  auto shared = std::make_shared<base>();
+  mp::borrower<base *> const from_shared(shared);
+  REQUIRE(from_shared->value == 1);
+}
+
+TEST_CASE("borrower of wrapped pointers", "[borrow_checks]")
+{
+  auto storage = std::make_unique<base>();
+  mp::owner<mp::strict_not_null<base *>> const owner(
+    mp::strict_not_null(storage.get()));
+  mp::borrower<mp::strict_not_null<base *>> const view(owner);
+  REQUIRE(view->value == 1);
+  mp::end_borrows(storage.get());
+  REQUIRE_THROWS_AS(view->value, mp::nullptr_exception);
+}
+
+TEST_CASE("borrow checks of the allocators", "[borrow_checks]")
+{
+  SECTION("size_class_pool")
+  {
+    using pool = mp::size_class_pool<>;
+    auto handle = pool::acquire<base>();
+    mp::borrower<mp::strict_not_null<base *>> const view(handle);
+    REQUIRE(view->value == 1);
+    pool::release(std::move(handle));
+    REQUIRE_THROWS_AS(view->value, mp::nullptr_exception);
+  }
+
+  SECTION("arena")
+  {
+    mp::arena arena;
+    mp::borrower<base *> const view(arena.make<base>());
+    REQUIRE(view->value == 1);
+    arena.release();
+    REQUIRE_THROWS_AS(view->value, mp::nullptr_exception);
+  }
+
+  SECTION("epoch_domain")
+  {
+    mp::owner<base *> owner = mp::make_owner(new base);
+    mp::borrower<base *> const view(owner);
+    domain::retire(std::move(owner));
+    REQUIRE(view->value == 1);
+    domain::synchronize();
+    REQUIRE_THROWS_AS(view->value, mp::nullptr_exception);
+  }
+}
+
+TEST_CASE("borrow checks report through the handler", "[borrow_checks]")
+{
+  mp::owner<base *> owner = mp::make_owner(new base);
+  mp::borrower<base *> const view(owner);
+  mp::delete_owned(std::move(owner));
+  try {
+    (void)view->value;
+    FAIL("no violation");
+  } catch (mp::nullptr_exception const &violation) {
+    REQUIRE(std::string(violation.what()).find("lifetime") != std::string::npos);
+  }
+}
+
+// NOLINTEND
@@ -4,6 +4,8 @@
 #include <sstream>
 
 #include <gsl/gsl>
+#include <memory>
+#include <unordered_map>
 
 namespace mp = marcpawl::pointers;
 
@@ -450,4 +452,41 @@ TEST_CASE("gsl::not_null", "[borrower]")
   REQUIRE(42 == legacy(var_not_null_borrower.get().get()));
 }
 
+TEST_CASE("hashing", "[borrower]")
+{
+  Child child;
+  Child other;
+  auto borrower = mp::make_borrower(&child);
+  REQUIRE(std::hash<mp::borrower<Child *>>{}(borrower)
+          == std::hash<Child *>{}(&child));
+
+  std::unordered_map<mp::borrower<Child *>, int, mp::pointer_hash,
+    mp::pointer_equal>
+    map{ { borrower, 1 } };
+  SECTION("raw pointer")
+  {
+    REQUIRE(map.find(&child) != map.end());
+    REQUIRE(map.find(static_cast<Child const *>(&child)) != map.end());
+    REQUIRE(map.find(&other) == map.end());
+  }
+  SECTION("strict_not_null")
+  {
+    mp::strict_not_null<Child *> not_null{ &child };
+    REQUIRE(map.find(not_null)->second == 1);
+    REQUIRE(!map.contains(mp::strict_not_null<Child *>{ &other }));
+  }
+  SECTION("owner")
+  {
+    mp::owner<Child *> owner{ &child };
+    REQUIRE(map.contains(owner));
+  }
+  SECTION("smart pointer")
+  {
+    auto owned = std::make_unique<Child>();
+    REQUIRE(!map.contains(owned));
+    map.emplace(mp::make_borrower(owned), 2);
+    REQUIRE(map.find(owned)->second == 2);
+  }
+}
+
 // NOLINTEND (cppcoreguidelines-avoid-magic-numbers)
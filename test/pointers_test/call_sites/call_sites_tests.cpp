@@ -0,0 +1,153 @@
+#include "marcpawl/pointers/call_sites.hpp"
+#include "marcpawl/pointers/ptr.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <optional>
+#include <source_location>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mp = marcpawl::pointers;
+
+// NOLINTBEGIN (cppcoreguidelines-avoid-magic-numbers)
+
+#if !defined(MP_CALL_SITE_COUNTERS)
+#error "must be built with MP_CALL_SITE_COUNTERS"
+#endif
+
+namespace {
+// Set by every thread that calls visit_site.
+std::atomic<std::uint_least32_t> visit_line{ 0 };
+
+int visit_site(mp::maybe_null<int *> ptr)
+{
+  visit_line = std::source_location::current().line() + 1;
+  return ptr.visit([](std::nullptr_t) { return 0; },
+    [](mp::strict_not_null<int *> p) { return *p; });
+}
+
+std::optional<mp::call_site_counts> site_of(std::uint_least32_t line)
+{
+  for (auto const &site : mp::call_site_snapshot()) {
+    if (site.line == line
+        && std::string(site.file).find("call_sites_tests")
+             != std::string::npos) {
+      return site;
+    }
+  }
+  return std::nullopt;
+}
+
+std::string read_back(void (*write)(std::FILE *,
+  std::vector<mp::call_site_counts> const &))
+{
+  std::FILE *const file = std::tmpfile();
+  REQUIRE(file != nullptr);
+  write(file, mp::call_site_snapshot());
+  std::rewind(file);
+  std::string text;
+  for (int c = std::fgetc(file); c != EOF; c = std::fgetc(file)) {
+    text.push_back(static_cast<char>(c));
+  }
+  (void)std::fclose(file);
+  return text;
+}
+}// namespace
+
+TEST_CASE("visit is counted at its caller", "[call_sites]")
+{
+  mp::reset_call_sites();
+  int value = 3;
+  for (int i = 0; i < 10; ++i) {
+    (void)visit_site(mp::maybe_null<int *>(i % 5 == 0 ? nullptr : &value));
+  }
+  auto const site = site_of(visit_line);
+  REQUIRE(site.has_value());
+  REQUIRE(site->calls == 10);
+  REQUIRE(site->null_branches == 2);
+  REQUIRE(site->violations == 0);
+  REQUIRE(site->null_ratio() == 0.2);
+  REQUIRE(std::string(site->function).find("visit_site") != std::string::npos);
+}
+
+TEST_CASE("conversions and null checks are counted", "[call_sites]")
+{
+  mp::reset_call_sites();
+  int value = 3;
+  mp::maybe_null<int *> const null;
+  mp::maybe_null<int *> const some(&value);
+
+  auto const optional_line = std::source_location::current().line() + 1;
+  (void)null.as_optional_not_null();
+  auto const variant_line = std::source_location::current().line() + 1;
+  (void)some.as_variant_not_null();
+  auto const check_line = std::source_location::current().line() + 1;
+  REQUIRE_THROWS_AS(
+    mp::strict_not_null<int *>(null.ptr_), mp::nullptr_exception);
+
+  auto const optional = site_of(optional_line);
+  REQUIRE(optional.has_value());
+  REQUIRE(optional->calls == 1);
+  REQUIRE(optional->null_branches == 1);
+
+  auto const variant = site_of(variant_line);
+  REQUIRE(variant.has_value());
+  REQUIRE(variant->calls == 1);
+  REQUIRE(variant->null_branches == 0);
+
+  auto const check = site_of(check_line);
+  REQUIRE(check.has_value());
+  REQUIRE(check->calls == 1);
+  REQUIRE(check->violations == 1);
+}
+
+TEST_CASE("counts of exited threads are kept", "[call_sites]")
+{
+  mp::reset_call_sites();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([] {
+      for (int i = 0; i < 100; ++i) {
+        (void)visit_site(mp::maybe_null<int *>(nullptr));
+      }
+    });
+  }
+  for (auto &t : threads) { t.join(); }
+  (void)visit_site(mp::maybe_null<int *>(nullptr));
+
+  auto const site = site_of(visit_line);
+  REQUIRE(site.has_value());
+  REQUIRE(site->calls == 401);
+  REQUIRE(site->null_branches == 401);
+  REQUIRE(mp::call_sites_dropped() == 0);
+
+  // Sites left uncounted by a reset are not in the snapshot.
+  mp::reset_call_sites();
+  REQUIRE(!site_of(visit_line).has_value());
+}
+
+TEST_CASE("call sites are written as JSON and CSV", "[call_sites]")
+{
+  mp::reset_call_sites();
+  (void)visit_site(mp::maybe_null<int *>(nullptr));
+
+  std::string const json = read_back(&mp::write_call_sites_json);
+  REQUIRE(json.front() == '[');
+  REQUIRE(json.find("\"line\": " + std::to_string(visit_line.load()))
+          != std::string::npos);
+  REQUIRE(json.find("\"calls\": 1, \"null_branches\": 1, \"violations\": 0")
+          != std::string::npos);
+
+  std::string const csv = read_back(&mp::write_call_sites_csv);
+  REQUIRE(csv.rfind("file,line,column,function,calls,null_branches,violations\n",
+            0)
+          == 0);
+  REQUIRE(csv.find("," + std::to_string(visit_line.load()) + ",")
+          != std::string::npos);
+  REQUIRE(csv.find(",1,1,0\n") != std::string::npos);
+}
+
+// NOLINTEND
@@ -0,0 +1,251 @@
+// Functions compiled at -O2 whose code must be no larger than a raw pointer
+// twin.  compare_codegen.cmake disassembles this object and compares every
+// codegen::<operation>__<type> function against codegen::<operation>__raw.
+
+#include "marcpawl/pointers/ptr.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+// NOLINTBEGIN
+
+namespace mp = marcpawl::pointers;
+
+// Types used in the signatures below have external linkage, otherwise the
+// functions would be internal and dropped.
+namespace codegen {
+
+struct node
+{
+  int value;
+  node *next;
+};
+
+template<template<typename> class Link> struct list_node
+{
+  int value;
+  Link<list_node> next;
+};
+
+// A 3 level object graph, with nullable links.
+struct leaf
+{
+  int value;
+};
+struct middle
+{
+  leaf *next;
+};
+struct top
+{
+  middle *next;
+};
+
+template<typename T> using raw_link = T *;
+template<typename T> using maybe_null_link = mp::maybe_null<T *>;
+template<typename T> using borrower_link = mp::borrower<T *>;
+
+}// namespace codegen
+
+namespace {
+
+// Same layout and the same calling convention as the raw pointer.
+template<typename W, typename T> constexpr bool same_as_raw_pointer()
+{
+  static_assert(sizeof(W) == sizeof(T *));
+  static_assert(alignof(W) == alignof(T *));
+  static_assert(std::is_trivially_copyable_v<W>);
+  static_assert(std::is_trivially_destructible_v<W>);
+  return true;
+}
+
+template<typename T> constexpr bool wrappers_are_raw_pointers()
+{
+  static_assert(same_as_raw_pointer<mp::maybe_null<T *>, T>());
+  static_assert(same_as_raw_pointer<mp::borrower<T *>, T>());
+  static_assert(same_as_raw_pointer<mp::owner<T *>, T>());
+  static_assert(same_as_raw_pointer<mp::strict_not_null<T *>, T>());
+  return true;
+}
+
+static_assert(wrappers_are_raw_pointers<int>());
+static_assert(wrappers_are_raw_pointers<int const>());
+static_assert(wrappers_are_raw_pointers<codegen::node>());
+static_assert(wrappers_are_raw_pointers<codegen::node const>());
+
+}// namespace
+
+namespace codegen {
+
+// Dereference
+int deref__raw(int *p) { return *p; }
+int deref__borrower(mp::borrower<int *> p) { return *p; }
+int deref__owner(mp::owner<int *> p) { return *p; }
+int deref__strict_not_null(mp::strict_not_null<int *> p) { return *p; }
+
+// Member access
+int arrow__raw(node *p) { return p->value; }
+int arrow__borrower(mp::borrower<node *> p) { return p->value; }
+int arrow__owner(mp::owner<node *> p) { return p->value; }
+int arrow__strict_not_null(mp::strict_not_null<node *> p) { return p->value; }
+
+// Unwrapping
+int *get__raw(int *p) { return p; }
+int *get__borrower(mp::borrower<int *> p) { return p.get(); }
+int *get__owner(mp::owner<int *> p) { return p.get(); }
+int *get__strict_not_null(mp::strict_not_null<int *> p) { return p.get(); }
+
+// Passing and returning by value
+int *pass__raw(int *p) { return p; }
+mp::maybe_null<int *> pass__maybe_null(mp::maybe_null<int *> p) { return p; }
+mp::borrower<int *> pass__borrower(mp::borrower<int *> p) { return p; }
+mp::owner<int *> pass__owner(mp::owner<int *> p) { return p; }
+mp::strict_not_null<int *> pass__strict_not_null(mp::strict_not_null<int *> p)
+{
+  return p;
+}
+
+// Comparisons
+bool equal__raw(int *a, int *b) { return a == b; }
+bool equal__maybe_null(mp::maybe_null<int *> a, mp::maybe_null<int *> b)
+{
+  return a == b;
+}
+bool equal__borrower(mp::borrower<int *> a, mp::borrower<int *> b)
+{
+  return a == b;
+}
+bool equal__owner(mp::owner<int *> a, mp::owner<int *> b) { return a == b; }
+bool equal__strict_not_null(mp::strict_not_null<int *> a,
+  mp::strict_not_null<int *> b)
+{
+  return a == b;
+}
+
+bool less__raw(int *a, int *b) { return a < b; }
+bool less__maybe_null(mp::maybe_null<int *> a, mp::maybe_null<int *> b)
+{
+  return a < b;
+}
+bool less__borrower(mp::borrower<int *> a, mp::borrower<int *> b)
+{
+  return a < b;
+}
+bool less__owner(mp::owner<int *> a, mp::owner<int *> b) { return a < b; }
+bool less__strict_not_null(mp::strict_not_null<int *> a,
+  mp::strict_not_null<int *> b)
+{
+  return a < b;
+}
+
+bool is_null__raw(int *p) { return p == nullptr; }
+bool is_null__maybe_null(mp::maybe_null<int *> p) { return !p; }
+bool is_null__borrower(mp::borrower<int *> p) { return p == nullptr; }
+bool is_null__owner(mp::owner<int *> p) { return p == nullptr; }
+
+// Null dispatch
+int visit__raw(int *p)
+{
+  if (p == nullptr) { return -1; }
+  return *p;
+}
+int visit__maybe_null(mp::maybe_null<int *> p)
+{
+  return p.visit([](std::nullptr_t) { return -1; },
+    [](mp::strict_not_null<int *> q) { return *q; });
+}
+
+// A test in the handler folds away, the pointer is tested once.
+int visit_retest__raw(int *p)
+{
+  if (p == nullptr) { return -1; }
+  return *p;
+}
+int visit_retest__maybe_null(mp::maybe_null<int *> p)
+{
+  return p.visit([](std::nullptr_t) { return -1; },
+    [](mp::strict_not_null<int *> q) { return q.get() == nullptr ? -2 : *q; });
+}
+
+// Unchecked construction, nothing is tested.
+int assume__raw(int *p) { return *p; }
+int assume__strict_not_null(int *p)
+{
+  mp::strict_not_null<int *> const q{ mp::assume_not_null, p };
+  return q.get() == nullptr ? -1 : *q;
+}
+
+// Construction from a constant address, nothing is tested.
+int global_value;
+int *constant__raw() { return &global_value; }
+int *constant__strict_not_null()
+{
+  return mp::constant_not_null(&global_value).get();
+}
+
+int as_optional__raw(int *p)
+{
+  if (p == nullptr) { return -1; }
+  return *p;
+}
+int as_optional__maybe_null(mp::maybe_null<int *> p)
+{
+  auto opt = p.as_optional_not_null();
+  if (!opt.has_value()) { return -1; }
+  return **opt;
+}
+
+// Pointer chasing
+int walk__raw(list_node<raw_link> *n)
+{
+  int sum = 0;
+  while (n != nullptr) {
+    sum += n->value;
+    n = n->next;
+  }
+  return sum;
+}
+int walk__borrower(mp::borrower<list_node<borrower_link> *> n)
+{
+  int sum = 0;
+  while (n != nullptr) {
+    sum += n->value;
+    n = n->next;
+  }
+  return sum;
+}
+int walk__maybe_null(mp::maybe_null<list_node<maybe_null_link> *> n)
+{
+  using node_ptr = mp::strict_not_null<list_node<maybe_null_link> *>;
+  int sum = 0;
+  bool more = true;
+  while (more) {
+    more = n.visit([](std::nullptr_t) { return false; },
+      [&](node_ptr p) {
+        sum += p->value;
+        n = p->next;
+        return true;
+      });
+  }
+  return sum;
+}
+
+// Navigation
+int chain__raw(top *t)
+{
+  if (t == nullptr || t->next == nullptr || t->next->next == nullptr) {
+    return -1;
+  }
+  return t->next->next->value;
+}
+int chain__maybe_null(mp::maybe_null<top *> t)
+{
+  return t.then(&top::next)
+    .then(&middle::next)
+    .transform([](mp::strict_not_null<leaf *> l) { return l->value; })
+    .value_or(-1);
+}
+
+}// namespace codegen
+
+// NOLINTEND
@@ -0,0 +1,169 @@
+# Compares the code generated for each wrapper in codegen_pairs.cpp against
+# its raw pointer twin.
+#
+# Every function codegen::<operation>__<type> is compared with
+# codegen::<operation>__raw.  Alignment padding is dropped and jump targets
+# are replaced by instruction indices, so that a different placement in the
+# object file does not matter.  A wrapper passes when its instructions are
+# identical to the raw pointer version, or when it has no more instructions
+# and no more bytes of code.
+#
+# Usage:
+#   cmake -DOBJDUMP=<objdump> -DNM=<nm> -DOBJECT=<object file>
+#         -P compare_codegen.cmake
+
+foreach(variable OBJDUMP NM OBJECT)
+  if(NOT ${variable})
+    message(FATAL_ERROR "${variable} is not set")
+  endif()
+endforeach()
+
+execute_process(
+  COMMAND ${NM} -S -C --defined-only ${OBJECT}
+  OUTPUT_VARIABLE symbols
+  RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "${NM} failed on ${OBJECT}")
+endif()
+
+execute_process(
+  COMMAND ${OBJDUMP} -d -r -C --no-show-raw-insn ${OBJECT}
+  OUTPUT_VARIABLE disassembly
+  RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "${OBJDUMP} failed on ${OBJECT}")
+endif()
+
+set(function_pattern "codegen::([A-Za-z0-9_]+)__([A-Za-z0-9_]+)\\(")
+
+# Symbol sizes, so that padding after a function is not part of it.
+string(REPLACE "\n" ";" symbol_lines "${symbols}")
+set(functions "")
+set(operations "")
+foreach(line IN LISTS symbol_lines)
+  if(line MATCHES "^[0-9a-f]+ ([0-9a-f]+) [Tt] ${function_pattern}")
+    set(function "${CMAKE_MATCH_2}__${CMAKE_MATCH_3}")
+    math(EXPR size_${function} "0x${CMAKE_MATCH_1}")
+    list(APPEND functions ${function})
+    list(APPEND operations ${CMAKE_MATCH_2})
+  endif()
+endforeach()
+list(REMOVE_DUPLICATES operations)
+if(NOT functions)
+  message(FATAL_ERROR "no codegen:: functions found in ${OBJECT}")
+endif()
+
+# Records the size of the previous instruction if it was padding.
+macro(end_instruction address)
+  if(previous_is_padding)
+    math(EXPR padding_${function}
+         "${padding_${function}} + ${address} - ${previous_address}")
+  endif()
+  set(previous_is_padding FALSE)
+endmacro()
+
+macro(end_function)
+  if(function)
+    math(EXPR function_end "${start} + ${size_${function}}")
+    end_instruction(${function_end})
+    math(EXPR bytes_${function}
+         "${size_${function}} - ${padding_${function}}")
+  endif()
+  set(function "")
+endmacro()
+
+string(REPLACE "\n" ";" lines "${disassembly}")
+set(function "")
+foreach(line IN LISTS lines)
+  if(line MATCHES "^([0-9a-f]+) <.*>:$")
+    end_function()
+    if(line MATCHES "^([0-9a-f]+) <${function_pattern}")
+      set(function "${CMAKE_MATCH_2}__${CMAKE_MATCH_3}")
+      math(EXPR start "0x${CMAKE_MATCH_1}")
+      set(code_${function} "")
+      set(offsets_${function} "")
+      set(padding_${function} 0)
+      set(previous_is_padding FALSE)
+    endif()
+  elseif(function AND line MATCHES "^[ \t]+([0-9a-f]+): (R_.*)$")
+    # Relocation of the previous instruction, e.g. the target of a call.
+    string(REGEX REPLACE "[ \t]+" " " relocation "${CMAKE_MATCH_2}")
+    list(APPEND code_${function} "${relocation}")
+  elseif(function AND line MATCHES "^ *([0-9a-f]+):\t(.*)$")
+    math(EXPR address "0x${CMAKE_MATCH_1}")
+    set(instruction "${CMAKE_MATCH_2}")
+    math(EXPR function_end "${start} + ${size_${function}}")
+    if(address LESS function_end)
+      end_instruction(${address})
+      set(previous_address ${address})
+      if(instruction MATCHES "^((data16|cs) )*nop|^xchg +%ax,%ax$")
+        set(previous_is_padding TRUE)
+      else()
+        math(EXPR offset "${address} - ${start}")
+        string(REGEX REPLACE "[ \t]*#.*$" "" instruction "${instruction}")
+        string(REGEX REPLACE
+          "[0-9a-f]+ <codegen::.*\\+0x([0-9a-f]+)>" "@\\1"
+          instruction "${instruction}")
+        string(REGEX REPLACE "[ \t]+" " " instruction "${instruction}")
+        list(APPEND code_${function} "${instruction}")
+        list(APPEND offsets_${function} ${offset})
+      endif()
+    endif()
+  endif()
+endforeach()
+end_function()
+
+# Replaces jump targets, recorded as @<hex offset>, by instruction indices.
+foreach(function IN LISTS functions)
+  set(resolved "")
+  foreach(instruction IN LISTS code_${function})
+    if(instruction MATCHES "@([0-9a-f]+)")
+      math(EXPR target "0x${CMAKE_MATCH_1}")
+      list(FIND offsets_${function} ${target} index)
+      string(REGEX REPLACE "@[0-9a-f]+" "<${index}>" instruction
+        "${instruction}")
+    endif()
+    list(APPEND resolved "${instruction}")
+  endforeach()
+  set(code_${function} "${resolved}")
+endforeach()
+
+function(listing function out)
+  string(REPLACE ";" "\n    " text "${code_${function}}")
+  set(${out} "  ${function} (${bytes_${function}} bytes)\n    ${text}"
+    PARENT_SCOPE)
+endfunction()
+
+set(failures 0)
+foreach(operation IN LISTS operations)
+  set(raw "${operation}__raw")
+  if(NOT DEFINED code_${raw})
+    message(SEND_ERROR "codegen::${raw} is missing")
+    math(EXPR failures "${failures} + 1")
+    continue()
+  endif()
+  list(LENGTH code_${raw} raw_count)
+  foreach(function IN LISTS functions)
+    if(NOT function MATCHES "^${operation}__" OR function STREQUAL raw)
+      continue()
+    endif()
+    list(LENGTH code_${function} count)
+    if("${code_${function}}" STREQUAL "${code_${raw}}")
+      message(STATUS "${function}: same code as ${raw}")
+    elseif(count LESS_EQUAL raw_count
+           AND bytes_${function} LESS_EQUAL bytes_${raw})
+      message(STATUS "${function}: different code, not larger than ${raw}")
+    else()
+      listing(${raw} raw_listing)
+      listing(${function} function_listing)
+      message(SEND_ERROR
+        "${function} is larger than ${raw}\n"
+        "${raw_listing}\n${function_listing}")
+      math(EXPR failures "${failures} + 1")
+    endif()
+  endforeach()
+endforeach()
+
+if(failures GREATER 0)
+  message(FATAL_ERROR "${failures} wrapper function(s) cost more than T*")
+endif()
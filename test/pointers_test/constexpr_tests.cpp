@@ -0,0 +1,142 @@
+#include "marcpawl/pointers/ptr.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+
+namespace mp = marcpawl::pointers;
+
+// NOLINTBEGIN (cppcoreguidelines-avoid-magic-numbers)
+
+// Built twice: constexpr_tests checks everything at compile time,
+// relaxed_constexpr_tests defines CATCH_CONFIG_RUNTIME_STATIC_REQUIRE and
+// runs the same checks at run time, for coverage and debugging.
+
+namespace {
+struct handler
+{
+  int (*run)(int);
+};
+
+constexpr handler doubler{ [](int value) { return 2 * value; } };
+constexpr handler negater{ [](int value) { return -value; } };
+
+struct node
+{
+  int value;
+  node const *next;
+};
+
+constexpr node last{ 3, nullptr };
+constexpr node middle{ 2, &last };
+constexpr node first{ 1, &middle };
+
+constexpr std::array<int, 2> values{ 1, 2 };
+
+// Neither table has a dynamic initialiser.
+constinit std::array<mp::strict_not_null<handler const *>, 2> handlers{
+  mp::constant_not_null(&doubler),
+  mp::constant_not_null(&negater)
+};
+
+constinit std::array<mp::borrower<node const *>, 3> nodes{
+  mp::borrower<node const *>(&first),
+  mp::make_borrower(&middle),
+  mp::borrower<node const *>(&last)
+};
+
+constinit mp::maybe_null<node const *> no_node{ nullptr };
+
+constexpr int sum(mp::maybe_null<node const *> list)
+{
+  int total = 0;
+  while (list != nullptr) {
+    total += list.visit([](std::nullptr_t) { return 0; },
+      [&](mp::strict_not_null<node const *> n) {
+        list = mp::maybe_null<node const *>(n->next);
+        return n->value;
+      });
+  }
+  return total;
+}
+
+constexpr int owned_value()
+{
+  mp::owner<int *> const owner = mp::make_owner(new int(5));
+  mp::borrower<int *> const view(owner);
+  mp::borrower<int *> const copy = owner.as_borrower();
+  int const value = *view + *copy;
+  mp::delete_owned(owner);
+  return value;
+}
+}// namespace
+
+TEST_CASE("constinit tables", "[constexpr]")
+{
+  REQUIRE(handlers[0]->run(3) == 6);
+  REQUIRE(handlers[1]->run(3) == -3);
+  REQUIRE(nodes[1]->value == 2);
+  REQUIRE(no_node == nullptr);
+  STATIC_REQUIRE(sizeof(handlers) == 2 * sizeof(handler const *));
+}
+
+TEST_CASE("strict_not_null in constant expressions", "[constexpr]")
+{
+  constexpr mp::strict_not_null<node const *> head(&first);
+  STATIC_REQUIRE(head->value == 1);
+  STATIC_REQUIRE((*head).next == &middle);
+  STATIC_REQUIRE(head == mp::strict_not_null<node const *>(&first));
+  STATIC_REQUIRE(head != mp::strict_not_null<node const *>(&last));
+  STATIC_REQUIRE(head == &first);
+  STATIC_REQUIRE(!!head);
+}
+
+TEST_CASE("maybe_null in constant expressions", "[constexpr]")
+{
+  constexpr mp::maybe_null<node const *> empty(nullptr);
+  constexpr mp::maybe_null<node const *> head(&first);
+  constexpr mp::maybe_null<node const *> copy = head;
+  STATIC_REQUIRE(empty == nullptr);
+  STATIC_REQUIRE(copy == head);
+  STATIC_REQUIRE(!empty);
+  STATIC_REQUIRE(sum(head) == 6);
+  STATIC_REQUIRE(sum(empty) == 0);
+  STATIC_REQUIRE(!empty.as_optional_not_null().has_value());
+  STATIC_REQUIRE(head.as_variant_not_null().index() == 1);
+  STATIC_REQUIRE(head.then(&node::next)
+                   .then(&node::next)
+                   .transform(
+                     [](mp::strict_not_null<node const *> n) { return n->value; })
+                   .value_or(0)
+                 == 3);
+  STATIC_REQUIRE(empty.value_or(mp::strict_not_null(&last))->value == 3);
+  STATIC_REQUIRE([] {
+    mp::maybe_null<node const *> m;
+    m = mp::maybe_null<node const *>(&middle);
+    return m == &middle;
+  }());
+}
+
+TEST_CASE("borrower and owner in constant expressions", "[constexpr]")
+{
+  constexpr mp::borrower<node const *> head(&first);
+  constexpr mp::borrower<node const *> copy = head;
+  STATIC_REQUIRE(head->value == 1);
+  STATIC_REQUIRE((*copy).value == 1);
+  STATIC_REQUIRE(head == copy);
+  STATIC_REQUIRE(head == &first);
+  STATIC_REQUIRE(mp::borrower<node const *>(nullptr) == nullptr);
+  constexpr mp::borrower<int const *> low(&values[0]);
+  constexpr mp::borrower<int const *> high(&values[1]);
+  STATIC_REQUIRE(low < high);
+  STATIC_REQUIRE(high >= low);
+  STATIC_REQUIRE(!(low > high));
+  STATIC_REQUIRE(owned_value() == 10);
+  STATIC_REQUIRE([] {
+    mp::borrower<node const *> b(&first);
+    b = mp::borrower<node const *>(&last);
+    return b->value;
+  }() == 3);
+}
+
+// NOLINTEND
@@ -0,0 +1,167 @@
+#include "marcpawl/pointers/epoch.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace mp = marcpawl::pointers;
+
+// NOLINTBEGIN (cppcoreguidelines-avoid-magic-numbers)
+
+namespace {
+std::atomic<int> destroyed{ 0 };
+
+struct node
+{
+  explicit node(int v) : value(v) {}
+  ~node()
+  {
+    alive = false;
+    destroyed.fetch_add(1, std::memory_order_relaxed);
+  }
+  node(node const &) = delete;
+  node &operator=(node const &) = delete;
+
+  int value;
+  std::atomic<bool> alive{ true };
+};
+
+struct basic_tag;
+using basic_domain = mp::epoch_domain<basic_tag>;
+using basic_guard = mp::epoch_guard<basic_domain>;
+
+struct threads_tag;
+using threads_domain = mp::epoch_domain<threads_tag>;
+
+struct reclaimer_tag;
+using reclaimer_domain = mp::epoch_domain<reclaimer_tag>;
+}// namespace
+
+TEST_CASE("epoch_guard keeps a retired object", "[epoch]")
+{
+  destroyed = 0;
+  mp::atomic_strict_not_null<node *> current{ mp::strict_not_null(
+    new node(1)) };
+
+  {
+    basic_guard const guard;
+    mp::borrower<node *> const borrowed = guard.borrow(current);
+    REQUIRE(borrowed->value == 1);
+
+    basic_domain::publish(current, mp::owner<node *>(new node(2)));
+    basic_domain::reclaim();
+    basic_domain::reclaim();
+    REQUIRE(destroyed == 0);
+    REQUIRE(basic_domain::pending() == 1);
+    REQUIRE(borrowed->value == 1);
+
+    // Nested, sees the new object.
+    basic_guard const inner;
+    REQUIRE(inner.borrow(current)->value == 2);
+  }
+
+  basic_domain::synchronize();
+  REQUIRE(destroyed == 1);
+  REQUIRE(basic_domain::pending() == 0);
+
+  basic_domain::retire(mp::owner<node *>(current.load().get()));
+  basic_domain::retire(mp::owner<node *>(nullptr));
+  basic_domain::synchronize();
+  REQUIRE(destroyed == 2);
+}
+
+TEST_CASE("epoch_guard sources", "[epoch]")
+{
+  node value(3);
+  std::atomic<node *> raw{ &value };
+  mp::atomic_maybe_null<node *> maybe;
+
+  basic_guard const guard;
+  STATIC_REQUIRE(
+    std::is_same_v<decltype(guard.borrow(raw)), mp::borrower<node *>>);
+  REQUIRE(guard.borrow(raw).get() == &value);
+  REQUIRE(guard.borrow(maybe).get() == nullptr);
+  maybe.store(mp::maybe_null<node *>(&value));
+  REQUIRE(guard.borrow(maybe)->value == 3);
+
+  STATIC_REQUIRE(!std::is_copy_constructible_v<basic_guard>);
+  STATIC_REQUIRE(!std::is_move_constructible_v<basic_guard>);
+}
+
+TEST_CASE("epoch_domain batches", "[epoch]")
+{
+  destroyed = 0;
+  std::uint64_t const start = basic_domain::epoch();
+  for (std::size_t i = 0; i < basic_domain::batch_size - 1; ++i) {
+    basic_domain::retire(mp::owner<node *>(new node(0)));
+  }
+  REQUIRE(basic_domain::pending() == basic_domain::batch_size - 1);
+
+  // A full batch advances the epoch, it is deleted by a later batch.
+  basic_domain::retire(mp::owner<node *>(new node(0)));
+  REQUIRE(basic_domain::epoch() > start);
+  basic_domain::synchronize();
+  REQUIRE(destroyed == static_cast<int>(basic_domain::batch_size));
+  REQUIRE(basic_domain::pending() == 0);
+}
+
+TEST_CASE("epoch_domain threads", "[epoch]")
+{
+  using guard = mp::epoch_guard<threads_domain>;
+  constexpr std::size_t readers = 4;
+  constexpr int updates = 20000;
+  mp::atomic_strict_not_null<node *> current{ mp::strict_not_null(
+    new node(0)) };
+  std::atomic<bool> done{ false };
+  std::array<bool, readers> ok{};
+
+  std::vector<std::thread> threads;
+  for (std::size_t r = 0; r < readers; ++r) {
+    threads.emplace_back([&, r] {
+      bool all = true;
+      while (!done.load(std::memory_order_acquire)) {
+        guard const g;
+        mp::borrower<node *> const borrowed = g.borrow(current);
+        all = all && borrowed->alive.load() && borrowed->value >= 0;
+      }
+      ok[r] = all;
+    });
+  }
+  for (int i = 1; i <= updates; ++i) {
+    threads_domain::publish(current, mp::owner<node *>(new node(i)));
+  }
+  done.store(true, std::memory_order_release);
+  for (auto &thread : threads) { thread.join(); }
+  for (bool const reader_ok : ok) { REQUIRE(reader_ok); }
+
+  threads_domain::retire(mp::owner<node *>(current.load().get()));
+  threads_domain::synchronize();
+  REQUIRE(threads_domain::pending() == 0);
+}
+
+TEST_CASE("epoch_reclaimer deletes in the background", "[epoch]")
+{
+  destroyed = 0;
+  mp::epoch_reclaimer<reclaimer_domain> const reclaimer(
+    std::chrono::milliseconds(1));
+  for (std::size_t i = 0; i < 4 * reclaimer_domain::batch_size; ++i) {
+    reclaimer_domain::retire(mp::owner<node *>(new node(0)));
+  }
+  REQUIRE(reclaimer_domain::pending() == 4 * reclaimer_domain::batch_size);
+
+  auto const deadline =
+    std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (reclaimer_domain::pending() != 0
+         && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  REQUIRE(reclaimer_domain::pending() == 0);
+  REQUIRE(destroyed == static_cast<int>(4 * reclaimer_domain::batch_size));
+}
+
+// NOLINTEND
@@ -1,10 +1,19 @@
 #include "marcpawl/pointers/ptr.hpp"
 #include <catch2/catch_test_macros.hpp>
 
+#include <cstdint>
+#include <source_location>
+#include <string>
+#include <type_traits>
+
 namespace mp = marcpawl::pointers;
 
 // NOLINTBEGIN (cppcoreguidelines-avoid-magic-numbers)
 
+namespace {
+void ignore_violation(mp::nullptr_exception const &) noexcept {}
+}// namespace
+
 TEST_CASE("default constructor", "[nullptr_exception]")
 {
   mp::nullptr_exception const exception{};
@@ -13,8 +22,41 @@ TEST_CASE("default constructor", "[nullptr_exception]")
 
 TEST_CASE("explicit constructor", "[nullptr_exception]")
 {
+  auto const line = std::source_location::current().line() + 1;
   mp::nullptr_exception const exception{ "message" };
   REQUIRE(std::string(exception.what()) == "message");
+  REQUIRE(exception.location().line() == line);
+}
+
+TEST_CASE("strict_not_null from a null pointer", "[nullptr_exception]")
+{
+  STATIC_REQUIRE(
+    !std::is_nothrow_constructible_v<mp::strict_not_null<int *>, int *>);
+  int *const null = nullptr;
+  std::uint_least32_t line = 0;
+  bool exceptionThrown = false;
+  try {
+    line = std::source_location::current().line() + 1;
+    mp::strict_not_null<int *> const ptr{ null };
+    FAIL("Expected exception");
+  } catch (mp::nullptr_exception const &e) {
+    exceptionThrown = true;
+    REQUIRE(std::string(e.what()) == "strict_not_null from a null pointer");
+    REQUIRE(e.location().line() == line);
+    REQUIRE(std::string(e.location().file_name()).ends_with(
+      "exception_tests.cpp"));
+  }
+  REQUIRE(exceptionThrown);
+}
+
+TEST_CASE("null violation handler", "[nullptr_exception]")
+{
+  auto const original = mp::get_null_violation_handler();
+  REQUIRE(original != nullptr);
+  REQUIRE(mp::set_null_violation_handler(&ignore_violation) == original);
+  REQUIRE(mp::get_null_violation_handler() == &ignore_violation);
+  REQUIRE(mp::set_null_violation_handler(nullptr) == &ignore_violation);
+  REQUIRE(mp::get_null_violation_handler() == original);
 }
 
 // NOLINTEND (cppcoreguidelines-avoid-magic-numbers)
@@ -0,0 +1,24 @@
+#include "marcpawl/pointers/intrusive.hpp"
+
+namespace mp = marcpawl::pointers;
+
+struct base : mp::ref_counted<base>
+{
+};
+
+struct derived : base
+{
+    int value = 0;
+};
+
+auto fail()
+{
+    // ERROR: ref_counted<base> would delete a derived as a base.
+    mp::intrusive_ptr<base> ptr = mp::make_intrusive<derived>();
+    return ptr;
+}
+
+int main(int,char**) {
+    fail();
+    return 0;
+}
@@ -0,0 +1,14 @@
+#include "marcpawl/pointers/ptr.hpp"
+
+namespace mp = marcpawl::pointers;
+
+auto fail()
+{
+    // ERROR: a null constant is not a constant expression of strict_not_null.
+    return mp::constant_not_null(static_cast<int*>(nullptr));
+}
+
+int main(int,char**) {
+    fail();
+    return 0;
+}
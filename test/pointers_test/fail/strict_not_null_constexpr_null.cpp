@@ -0,0 +1,12 @@
+#include "marcpawl/pointers/ptr.hpp"
+
+namespace mp = marcpawl::pointers;
+
+constexpr int const *null_data = nullptr;
+
+// ERROR: a null violation during constant evaluation does not compile.
+constexpr mp::strict_not_null<int const *> fail(null_data);
+
+int main(int,char**) {
+    return *fail;
+}
@@ -0,0 +1,18 @@
+#include "marcpawl/pointers/tagged.hpp"
+
+#include <cstdint>
+
+namespace mp = marcpawl::pointers;
+
+auto fail()
+{
+    std::int32_t p;
+    // ERROR: a 4 byte aligned pointee leaves 2 bits free, not 3.
+    mp::tagged<mp::borrower<std::int32_t*>, 3> ptr{mp::make_borrower(&p)};
+    return ptr;
+}
+
+int main(int,char**) {
+    fail();
+    return 0;
+}
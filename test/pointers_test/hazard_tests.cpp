@@ -0,0 +1,135 @@
+#include "marcpawl/pointers/hazard.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mp = marcpawl::pointers;
+
+// NOLINTBEGIN (cppcoreguidelines-avoid-magic-numbers)
+
+namespace {
+std::atomic<int> destroyed{ 0 };
+
+struct node
+{
+  explicit node(int v) : value(v) {}
+  ~node()
+  {
+    alive = false;
+    destroyed.fetch_add(1, std::memory_order_relaxed);
+  }
+  node(node const &) = delete;
+  node &operator=(node const &) = delete;
+
+  int value;
+  std::atomic<bool> alive{ true };
+};
+
+struct basic_tag;
+using basic_domain = mp::hazard_domain<basic_tag>;
+using basic_borrower = mp::hazard_borrower<node *, basic_domain>;
+
+struct threads_tag;
+using threads_domain = mp::hazard_domain<threads_tag>;
+}// namespace
+
+TEST_CASE("hazard_borrower keeps a retired object", "[hazard]")
+{
+  destroyed = 0;
+  mp::atomic_strict_not_null<node *> current{ mp::strict_not_null(
+    new node(1)) };
+
+  basic_borrower borrowed(current);
+  REQUIRE(borrowed);
+  REQUIRE(borrowed->value == 1);
+
+  node *const old = current.exchange(mp::strict_not_null(new node(2))).get();
+  basic_domain::retire(mp::owner<node *>(old));
+  basic_domain::reclaim();
+  REQUIRE(destroyed == 0);
+  REQUIRE(basic_domain::pending() == 1);
+  REQUIRE((*borrowed).value == 1);
+
+  // Taken again, from the new object.
+  borrowed.protect(current);
+  REQUIRE(borrowed->value == 2);
+  basic_domain::reclaim();
+  REQUIRE(destroyed == 1);
+  REQUIRE(basic_domain::pending() == 0);
+
+  borrowed.reset();
+  REQUIRE(!borrowed);
+  basic_domain::retire(mp::owner<node *>(current.load().get()));
+  basic_domain::reclaim();
+  REQUIRE(destroyed == 2);
+}
+
+TEST_CASE("hazard_borrower sources", "[hazard]")
+{
+  node value(3);
+  std::atomic<node *> raw{ &value };
+  mp::atomic_maybe_null<node *> maybe;
+
+  basic_borrower from_raw(raw);
+  REQUIRE(from_raw.get() == &value);
+  REQUIRE(from_raw.borrow().get() == &value);
+
+  basic_borrower from_null(maybe);
+  REQUIRE(!from_null);
+  REQUIRE(from_null.get() == nullptr);
+  maybe.store(mp::maybe_null<node *>(&value));
+  from_null.protect(maybe);
+  REQUIRE(from_null->value == 3);
+
+  STATIC_REQUIRE(!std::is_copy_constructible_v<basic_borrower>);
+  basic_borrower moved(std::move(from_raw));
+  REQUIRE(!from_raw);
+  REQUIRE(moved->value == 3);
+  from_raw = std::move(moved);
+  REQUIRE(from_raw->value == 3);
+}
+
+TEST_CASE("hazard_borrower threads", "[hazard]")
+{
+  using borrower = mp::hazard_borrower<node *, threads_domain>;
+  constexpr std::size_t readers = 4;
+  constexpr int updates = 20000;
+  mp::atomic_strict_not_null<node *> current{ mp::strict_not_null(
+    new node(0)) };
+  std::atomic<bool> done{ false };
+  std::array<bool, readers> ok{};
+
+  std::vector<std::thread> threads;
+  for (std::size_t r = 0; r < readers; ++r) {
+    threads.emplace_back([&, r] {
+      bool all = true;
+      while (!done.load(std::memory_order_acquire)) {
+        borrower const borrowed(current);
+        all = all && borrowed->alive.load() && borrowed->value >= 0;
+      }
+      ok[r] = all;
+    });
+  }
+  for (int i = 1; i <= updates; ++i) {
+    node *const old =
+      current.exchange(mp::strict_not_null(new node(i))).get();
+    threads_domain::retire(mp::owner<node *>(old));
+  }
+  done.store(true, std::memory_order_release);
+  for (auto &thread : threads) { thread.join(); }
+  for (bool const reader_ok : ok) { REQUIRE(reader_ok); }
+
+  // Bounded by the scan threshold.
+  REQUIRE(threads_domain::pending() < threads_domain::min_scan);
+  threads_domain::retire(mp::owner<node *>(current.load().get()));
+  threads_domain::reclaim();
+  REQUIRE(threads_domain::pending() == 0);
+}
+
+// NOLINTEND
@@ -0,0 +1,150 @@
+#include "marcpawl/pointers/intrusive.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <functional>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace mp = marcpawl::pointers;
+
+// NOLINTBEGIN (cppcoreguidelines-avoid-magic-numbers)
+
+namespace {
+int destroyed = 0;
+
+// Virtual, so that ref_counted<node> may delete a derived.
+struct node : mp::ref_counted<node>
+{
+  explicit node(int v) : value(v) {}
+  virtual ~node() { ++destroyed; }
+
+  int value;
+};
+
+struct derived : node
+{
+  derived() : node(7) {}
+};
+
+struct local_node : mp::ref_counted<local_node, mp::ref_counting::single_thread>
+{
+  int value = 5;
+};
+
+// Counts of its own, found by ADL.
+struct custom
+{
+  int refs = 0;
+  int value = 9;
+};
+void intrusive_ptr_add_ref(custom const *c) noexcept
+{
+  ++const_cast<custom *>(c)->refs;
+}
+void intrusive_ptr_release(custom const *c) noexcept
+{
+  --const_cast<custom *>(c)->refs;
+}
+}// namespace
+
+TEST_CASE("intrusive_ptr counts references", "[intrusive]")
+{
+  destroyed = 0;
+  STATIC_REQUIRE(sizeof(mp::intrusive_ptr<node>) == sizeof(node *));
+
+  {
+    mp::intrusive_ptr<node> first = mp::make_intrusive<node>(1);
+    REQUIRE(first->use_count() == 1);
+    {
+      mp::intrusive_ptr<node> second = first;
+      REQUIRE(first->use_count() == 2);
+      mp::intrusive_ptr<node> third = std::move(second);
+      REQUIRE(second == nullptr);
+      REQUIRE(third == first);
+      REQUIRE(first->use_count() == 2);
+    }
+    REQUIRE(first->use_count() == 1);
+
+    node *const raw = first.detach();
+    REQUIRE(!first);
+    REQUIRE(raw->use_count() == 1);
+    first = mp::intrusive_ptr<node>(mp::adopt_ref, raw);
+    REQUIRE((*first).value == 1);
+
+    mp::intrusive_ptr<node> const base = mp::make_intrusive<derived>();
+    REQUIRE(base->value == 7);
+    REQUIRE(destroyed == 0);
+  }
+  REQUIRE(destroyed == 2);
+
+  mp::intrusive_ptr<local_node> const local = mp::make_intrusive<local_node>();
+  mp::intrusive_ptr<local_node> const copy = local;
+  REQUIRE(local->use_count() == 2);
+
+  custom c;
+  {
+    mp::intrusive_ptr<custom> const p(&c);
+    REQUIRE(c.refs == 1);
+  }
+  REQUIRE(c.refs == 0);
+}
+
+TEST_CASE("intrusive_ptr in wrappers", "[intrusive]")
+{
+  destroyed = 0;
+  {
+    mp::strict_not_null<mp::intrusive_ptr<node>> const not_null(
+      mp::make_intrusive<node>(2));
+    REQUIRE(not_null->value == 2);
+    REQUIRE(not_null.get()->use_count() == 1);
+
+    // Borrowing leaves the count alone.
+    mp::borrower<node *> const borrowed(not_null.get());
+    REQUIRE(borrowed->value == 2);
+    REQUIRE(not_null.get()->use_count() == 1);
+
+    mp::maybe_null<mp::intrusive_ptr<node>> maybe(not_null.get());
+    REQUIRE(not_null.get()->use_count() == 2);
+    REQUIRE(maybe.visit([](std::nullptr_t) { return 0; },
+              [](auto const &p) { return p->value; })
+            == 2);
+
+    mp::maybe_null<mp::intrusive_ptr<node>> const empty;
+    REQUIRE(!empty.as_optional_not_null().has_value());
+
+    mp::intrusive_ptr<node> null;
+    REQUIRE_THROWS_AS(
+      mp::strict_not_null<mp::intrusive_ptr<node>>(null), mp::nullptr_exception);
+
+    std::unordered_set<mp::intrusive_ptr<node>> set;
+    set.insert(not_null.get());
+    REQUIRE(set.contains(not_null.get()));
+    REQUIRE(mp::pointer_equal{}(not_null, borrowed));
+  }
+  REQUIRE(destroyed == 1);
+}
+
+TEST_CASE("intrusive_ptr threads", "[intrusive]")
+{
+  destroyed = 0;
+  {
+    mp::intrusive_ptr<node> const shared = mp::make_intrusive<node>(3);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&shared] {
+        for (int i = 0; i < 10000; ++i) {
+          mp::intrusive_ptr<node> const copy = shared;
+          (void)copy;
+        }
+      });
+    }
+    for (auto &thread : threads) { thread.join(); }
+    REQUIRE(shared->use_count() == 1);
+  }
+  REQUIRE(destroyed == 1);
+}
+
+// NOLINTEND
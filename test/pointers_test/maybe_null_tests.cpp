@@ -3,6 +3,10 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <gsl/gsl>
+#include <memory>
+#include <optional>
+#include <unordered_set>
+#include <variant>
 
 namespace mp = marcpawl::pointers;
 
@@ -323,7 +327,7 @@ TEST_CASE("as_variant_not_null", "[maybe_null]")
     mp::maybe_null<int *> const maybe_null(data);
     mp::maybe_null<int *>::variant_not_null variant =
       maybe_null.as_variant_not_null();
-    bool is_null = std::holds_alternative<std::nullptr_t>(variant);
+    bool is_null = mp::holds_alternative<std::nullptr_t>(variant);
     REQUIRE(is_null);
   }
   SECTION("from non-null")
@@ -331,10 +335,10 @@ TEST_CASE("as_variant_not_null", "[maybe_null]")
     int data = 32;
     mp::maybe_null<int *> maybe_null(&data);
     auto variant = maybe_null.as_variant_not_null();
-    auto has_data = std::holds_alternative<mp::strict_not_null<int *>>(variant);
+    auto has_data = mp::holds_alternative<mp::strict_not_null<int *>>(variant);
     REQUIRE(has_data);
     mp::strict_not_null<int *> not_null =
-      std::get<mp::strict_not_null<int *>>(variant);
+      mp::get<mp::strict_not_null<int *>>(variant);
     REQUIRE(data == *not_null);
   }
 }
@@ -411,6 +415,120 @@ TEST_CASE("visit", "[maybe_null]")
   }
 }
 
+TEST_CASE("visit with likelihood", "[maybe_null]")
+{
+  int data = 7;
+  mp::maybe_null<int *> const some(&data);
+  mp::maybe_null<int *> const none;
+  auto handle_null = [](std::nullptr_t) { return -1; };
+  auto handle_data = [](mp::strict_not_null<int *> p) { return *p; };
+
+  REQUIRE(some.visit<mp::likely_not_null>(handle_null, handle_data) == 7);
+  REQUIRE(none.visit<mp::likely_not_null>(handle_null, handle_data) == -1);
+  REQUIRE(some.visit<mp::likely_null>(handle_null, handle_data) == 7);
+  REQUIRE(none.visit<mp::likely_null>(handle_null, handle_data) == -1);
+
+  REQUIRE(some.as_optional_not_null<mp::likely_not_null>().has_value());
+  REQUIRE(!none.as_optional_not_null<mp::likely_null>().has_value());
+  REQUIRE(mp::holds_alternative<std::nullptr_t>(
+    none.as_variant_not_null<mp::likely_not_null>()));
+  REQUIRE(mp::holds_alternative<mp::strict_not_null<int *>>(
+    some.as_variant_not_null<mp::likely_null>()));
+
+  constexpr int answer = [] {
+    int value = 42;
+    mp::maybe_null<int *> const ptr(&value);
+    return ptr.visit<mp::likely_not_null>(
+      [](std::nullptr_t) { return 0; },
+      [](mp::strict_not_null<int *> p) { return *p; });
+  }();
+  STATIC_REQUIRE(answer == 42);
+}
+
+namespace {
+struct leaf
+{
+  int value = 0;
+};
+
+struct middle
+{
+  std::unique_ptr<leaf> owned;
+  mp::maybe_null<leaf *> next;
+  leaf *first() const { return owned.get(); }
+};
+
+struct top
+{
+  middle *next = nullptr;
+};
+}// namespace
+
+TEST_CASE("navigation", "[maybe_null]")
+{
+  middle m{ std::make_unique<leaf>(leaf{ 7 }), mp::maybe_null<leaf *>{} };
+  top full{ &m };
+  top broken{};
+  auto const value = [](mp::strict_not_null<leaf *> l) { return l->value; };
+
+  SECTION("then")
+  {
+    REQUIRE(mp::maybe_null(&full)
+              .then(&top::next)
+              .then(&middle::owned)
+              .transform(value)
+              .value_or(-1)
+            == 7);
+    REQUIRE(mp::maybe_null(&full)
+              .then(&top::next)
+              .then(&middle::first)
+              .transform(value)
+              == std::optional<int>(7));
+    REQUIRE(!mp::maybe_null(&full)
+               .then(&top::next)
+               .then(&middle::next)
+               .transform(value)
+               .has_value());
+    REQUIRE(!mp::maybe_null(&broken)
+               .then(&top::next)
+               .then([](middle const &n) { return n.first(); })
+               .transform(value)
+               .has_value());
+    REQUIRE(!mp::maybe_null<top *>()
+               .then(&top::next)
+               .then(&middle::owned)
+               .transform(value)
+               .has_value());
+    REQUIRE(mp::maybe_null(&full)
+              .then(&top::next)
+              .then(&middle::owned)
+              .transform(&leaf::value)
+            == std::optional<int>(7));
+  }
+
+  SECTION("and_then")
+  {
+    auto const next = [](mp::strict_not_null<top *> t) {
+      return mp::maybe_null(t->next);
+    };
+    REQUIRE(mp::maybe_null(&full).and_then(next) == mp::maybe_null(&m));
+    REQUIRE(
+      mp::maybe_null(&broken).and_then(next) == mp::maybe_null<middle *>());
+    REQUIRE(
+      mp::maybe_null<top *>().and_then(next) == mp::maybe_null<middle *>());
+  }
+
+  SECTION("or_else and value_or")
+  {
+    leaf fallback{ 3 };
+    auto const other = [&fallback] { return mp::maybe_null(&fallback); };
+    REQUIRE(m.next.or_else(other).transform(value) == std::optional<int>(3));
+    REQUIRE(mp::maybe_null(m.owned.get()).or_else(other).transform(value)
+            == std::optional<int>(7));
+    REQUIRE(m.next.value_or(mp::strict_not_null(&fallback))->value == 3);
+  }
+}
+
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wdeprecated-declarations"
 TEST_CASE("get", "[maybe_null]")
@@ -484,14 +602,19 @@ TEST_CASE("star operator", "[maybe_null]")
 }
 #pragma clang diagnostic pop
 
-// TEST_CASE("hashing", "[maybe_null]")
-// {
-//   int data = 3;
-//   auto maybe_null = mp::make_maybe_null(&data);
-//   auto actual = std::hash(maybe_null);
-//   auto execpted = std::hash(&data);
-//   REQUIRE(actual == expected);
-// }
+TEST_CASE("hashing", "[maybe_null]")
+{
+  int data = 3;
+  auto maybe_null = mp::make_maybe_null(&data);
+  auto actual = std::hash<mp::maybe_null<int *>>{}(maybe_null);
+  auto expected = std::hash<int *>{}(&data);
+  REQUIRE(actual == expected);
+
+  std::unordered_set<mp::maybe_null<int *>, mp::pointer_hash, mp::pointer_equal>
+    set{ maybe_null, mp::maybe_null<int *>{ nullptr } };
+  REQUIRE(set.contains(&data));
+  REQUIRE(set.contains(static_cast<int *>(nullptr)));
+}
 
 
 // NOLINTEND (cppcoreguidelines-avoid-magic-numbers)
@@ -0,0 +1,65 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <sstream>
+#include <unordered_set>
+#include <utility>
+
+import marcpawl.pointers;
+
+namespace mp = marcpawl::pointers;
+
+// NOLINTBEGIN (cppcoreguidelines-avoid-magic-numbers)
+
+namespace {
+struct node
+{
+  int value;
+  mp::maybe_null<node *> next;
+};
+}// namespace
+
+TEST_CASE("maybe_null through the module", "[module]")
+{
+  node last{ 2, mp::maybe_null<node *>() };
+  node first{ 1, mp::maybe_null<node *>(&last) };
+  mp::maybe_null<node *> const head(&first);
+  mp::maybe_null<node *> const empty;
+
+  REQUIRE(head != nullptr);
+  REQUIRE(!empty);
+  REQUIRE(head.visit([](std::nullptr_t) { return 0; },
+            [](mp::strict_not_null<node *> n) { return n->value; })
+          == 1);
+  REQUIRE(head.then(&node::next).transform(&node::value)
+          == std::optional<int>(2));
+  REQUIRE(!empty.as_optional_not_null().has_value());
+  REQUIRE(mp::holds_alternative<std::nullptr_t>(empty.as_variant_not_null()));
+  REQUIRE(mp::get<1>(head.as_variant_not_null()) == &first);
+}
+
+TEST_CASE("borrower and owner through the module", "[module]")
+{
+  mp::owner<node *> owner = mp::make_owner(new node{ 3, {} });
+  mp::borrower<node *> const view(owner);
+  REQUIRE(view->value == 3);
+  REQUIRE(view == owner.as_borrower());
+
+  std::unordered_set<mp::borrower<node *>> views{ view };
+  REQUIRE(views.contains(view));
+
+  std::ostringstream printed;
+  printed << view;
+  REQUIRE(!printed.str().empty());
+  mp::delete_owned(std::move(owner));
+}
+
+TEST_CASE("null violations through the module", "[module]")
+{
+  node *const null = nullptr;
+  REQUIRE_THROWS_AS(mp::strict_not_null<node *>(null), mp::nullptr_exception);
+}
+
+// NOLINTEND
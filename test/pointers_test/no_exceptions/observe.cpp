@@ -0,0 +1,78 @@
+// MP_NULL_POLICY_OBSERVE without exceptions: null violations go to the
+// handler, and the program carries on.
+
+#include "marcpawl/pointers/arena.hpp"
+#include "marcpawl/pointers/pointer_set.hpp"
+#include "marcpawl/pointers/pool.hpp"
+#include "marcpawl/pointers/ptr.hpp"
+#include "marcpawl/pointers/relative.hpp"
+#include "marcpawl/pointers/tagged.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <source_location>
+#include <utility>
+
+namespace mp = marcpawl::pointers;
+
+// NOLINTBEGIN
+
+#if defined(__cpp_exceptions)
+#error "must be built without exceptions"
+#endif
+
+namespace {
+int violations = 0;
+std::source_location last_location;
+char const *last_message = nullptr;
+
+void count_violation(mp::nullptr_exception const &violation) noexcept
+{
+  ++violations;
+  last_location = violation.location();
+  last_message = violation.what();
+}
+
+int failures = 0;
+
+void check(bool condition, char const *what)
+{
+  if (!condition) {
+    std::fprintf(stderr, "failed: %s\n", what);
+    ++failures;
+  }
+}
+}// namespace
+
+int main()
+{
+  static_assert(
+    mp::details::active_null_policy == mp::null_policy::observe);
+  mp::set_null_violation_handler(&count_violation);
+
+  int value = 7;
+  mp::strict_not_null<int *> const ptr{ &value };
+  check(*ptr == 7, "strict_not_null from a pointer");
+  check(violations == 0, "no violation for a pointer");
+
+  int *const null = nullptr;
+  auto const line = std::source_location::current().line() + 1;
+  mp::strict_not_null<int *> const observed{ null };
+  check(violations == 1, "violation for a null pointer");
+  check(last_location.line() == line, "violation at the caller");
+  check(std::strcmp(last_message, "strict_not_null from a null pointer") == 0,
+    "violation message");
+  check(observed.get() == nullptr, "carries on with the null pointer");
+
+  auto handle = mp::size_class_pool<>::acquire<int>(3);
+  check(*handle == 3, "pool acquire");
+  mp::size_class_pool<>::release(std::move(handle));
+
+  mp::pointer_set<mp::borrower<int *>> set;
+  check(set.insert(mp::borrower<int *>(&value)).second, "pointer_set insert");
+
+  mp::set_null_violation_handler(nullptr);
+  return failures == 0 ? 0 : 1;
+}
+
+// NOLINTEND
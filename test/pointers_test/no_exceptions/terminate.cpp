@@ -0,0 +1,47 @@
+// The default policy without exceptions, MP_NULL_POLICY_TERMINATE: a null
+// violation goes to the handler, then ends the program by std::terminate().
+
+#include "marcpawl/pointers/ptr.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+
+namespace mp = marcpawl::pointers;
+
+// NOLINTBEGIN
+
+#if defined(__cpp_exceptions)
+#error "must be built without exceptions"
+#endif
+
+static_assert(mp::details::active_null_policy == mp::null_policy::terminate);
+
+namespace {
+bool reported = false;
+
+void record_violation(mp::nullptr_exception const &) noexcept
+{
+  reported = true;
+}
+
+[[noreturn]] void terminated()
+{
+  std::_Exit(reported ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+}// namespace
+
+int main(int argc, char **)
+{
+  mp::set_null_violation_handler(&record_violation);
+  std::set_terminate(&terminated);
+
+  // Not known at compile time.
+  int *const null = argc > 0 ? nullptr : &argc;
+  mp::strict_not_null<int *> const ptr{ null };
+  std::fprintf(stderr, "failed: carried on after a null violation\n");
+  (void)*ptr;
+  return EXIT_FAILURE;
+}
+
+// NOLINTEND
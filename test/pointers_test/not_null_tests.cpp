@@ -1,5 +1,6 @@
 #include <cassert>
 #include <memory>
+#include <type_traits>
 
 #include "hierarchy.hpp"
 #include "marcpawl/pointers/ptr.hpp"
@@ -207,4 +208,64 @@ TEST_CASE("unique_ptr", "[not_null]")
 }
 
 
+TEST_CASE("copy", "[not_null]")
+{
+  STATIC_REQUIRE(std::is_trivially_copyable_v<mp::strict_not_null<int *>>);
+  STATIC_REQUIRE(
+    std::is_trivially_destructible_v<mp::strict_not_null<int *>>);
+  STATIC_REQUIRE(
+    !std::is_copy_constructible_v<mp::strict_not_null<std::unique_ptr<int>>>);
+
+  int first = 1;
+  int second = 2;
+  mp::strict_not_null<int *> destination{ &first };
+  mp::strict_not_null<int *> const source{ &second };
+  destination = source;
+  REQUIRE(&second == destination.get());
+  mp::strict_not_null<int *> copy{ destination };
+  REQUIRE(2 == *copy);
+}
+
+TEST_CASE("hashing", "[not_null]")
+{
+  int data = 32;
+  mp::strict_not_null<int *> not_null{ &data };
+  REQUIRE(std::hash<mp::strict_not_null<int *>>{}(not_null)
+          == std::hash<int *>{}(&data));
+
+  auto owned = std::make_unique<int>(4);
+  int *const address = owned.get();
+  mp::strict_not_null<std::unique_ptr<int>> unique{ std::move(owned) };
+  REQUIRE(std::hash<mp::strict_not_null<std::unique_ptr<int>>>{}(unique)
+          == std::hash<int *>{}(address));
+  REQUIRE(mp::pointer_equal{}(unique, address));
+}
+
+namespace {
+int global_data = 7;
+}
+
+TEST_CASE("assume_not_null", "[not_null]")
+{
+  int data = 32;
+  mp::strict_not_null<int *> const not_null{ mp::assume_not_null, &data };
+  REQUIRE(not_null.get() == &data);
+  REQUIRE(*not_null == 32);
+
+  auto owned = std::make_unique<int>(4);
+  mp::strict_not_null<std::unique_ptr<int>> const unique{ mp::assume_not_null,
+    std::move(owned) };
+  REQUIRE(*unique == 4);
+}
+
+TEST_CASE("constant_not_null", "[not_null]")
+{
+  constexpr mp::strict_not_null<int *> not_null =
+    mp::constant_not_null(&global_data);
+  STATIC_REQUIRE(not_null.get() == &global_data);
+  REQUIRE(*not_null == 7);
+  REQUIRE(*mp::constant_not_null(&global_data) == 7);
+}
+
+
 // NOLINTEND (cppcoreguidelines-avoid-magic-numbers)
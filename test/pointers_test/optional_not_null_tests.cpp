@@ -0,0 +1,107 @@
+#include "marcpawl/pointers/ptr.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <unordered_set>
+
+namespace mp = marcpawl::pointers;
+
+// NOLINTBEGIN (cppcoreguidelines-avoid-magic-numbers)
+
+namespace {
+constexpr int constant_data = 3;
+}// namespace
+
+TEST_CASE("optional_not_null layout", "[optional_not_null]")
+{
+  using optional = mp::optional_not_null<int *>;
+  STATIC_REQUIRE(sizeof(optional) == sizeof(int *));
+  STATIC_REQUIRE(std::is_trivially_copyable_v<optional>);
+  STATIC_REQUIRE(std::is_trivially_destructible_v<optional>);
+  STATIC_REQUIRE(
+    std::is_same_v<mp::maybe_null<int *>::optional_not_null, optional>);
+  STATIC_REQUIRE(
+    std::is_same_v<mp::maybe_null<std::unique_ptr<int>>::optional_not_null,
+      std::optional<mp::strict_not_null<std::unique_ptr<int>>>>);
+}
+
+TEST_CASE("optional_not_null state", "[optional_not_null]")
+{
+  int data = 3;
+  mp::optional_not_null<int *> empty;
+  REQUIRE(!empty.has_value());
+  REQUIRE(!empty);
+  REQUIRE(empty == std::nullopt);
+  REQUIRE_THROWS_AS(empty.value(), std::bad_optional_access);
+  REQUIRE(empty.value_or(mp::strict_not_null(&data)).get() == &data);
+
+  mp::optional_not_null<int *> full = mp::strict_not_null(&data);
+  REQUIRE(full.has_value());
+  REQUIRE(full.value().get() == &data);
+  REQUIRE(**full == 3);
+  REQUIRE(full->get() == &data);
+  REQUIRE(full == mp::strict_not_null(&data));
+  REQUIRE(full != empty);
+
+  full.swap(empty);
+  REQUIRE(!full.has_value());
+  REQUIRE(empty.has_value());
+  empty.reset();
+  REQUIRE(empty == full);
+
+  REQUIRE(*empty.emplace(&data) == 3);
+  REQUIRE_THROWS_AS(full.emplace(static_cast<int *>(nullptr)),
+    mp::nullptr_exception);
+  REQUIRE(!full.has_value());
+  empty = std::nullopt;
+  REQUIRE(!empty.has_value());
+}
+
+TEST_CASE("optional_not_null conversions", "[optional_not_null]")
+{
+  int data = 3;
+  mp::maybe_null<int *> const some(&data);
+  mp::maybe_null<int *> const none;
+  REQUIRE(some.as_optional_not_null().has_value());
+  REQUIRE(!none.as_optional_not_null().has_value());
+
+  std::optional<mp::strict_not_null<int *>> const standard =
+    some.as_optional_not_null();
+  REQUIRE(standard.has_value());
+  REQUIRE(standard->get() == &data);
+  mp::optional_not_null<int *> const back = standard;
+  REQUIRE(back.has_value());
+  std::optional<mp::strict_not_null<int *>> const empty =
+    none.as_optional_not_null();
+  REQUIRE(!empty.has_value());
+
+  mp::optional_not_null<int const *> const to_const = back;
+  REQUIRE(to_const->get() == &data);
+}
+
+TEST_CASE("optional_not_null hashing", "[optional_not_null]")
+{
+  int data = 3;
+  std::unordered_set<mp::optional_not_null<int *>> set;
+  set.insert(mp::optional_not_null<int *>{});
+  set.insert(mp::strict_not_null(&data));
+  REQUIRE(set.size() == 2);
+  REQUIRE(set.contains(std::nullopt));
+  REQUIRE(std::hash<mp::optional_not_null<int *>>{}(std::nullopt)
+          == std::hash<int *>{}(nullptr));
+}
+
+TEST_CASE("optional_not_null in constant expressions", "[optional_not_null]")
+{
+  constexpr mp::optional_not_null<int const *> empty;
+  constexpr mp::optional_not_null<int const *> full =
+    mp::constant_not_null(&constant_data);
+  STATIC_REQUIRE(!empty.has_value());
+  STATIC_REQUIRE(full.has_value());
+  STATIC_REQUIRE(**full == 3);
+}
+
+// NOLINTEND
@@ -55,5 +55,14 @@ TEST_CASE("to_borrower", "[owner]")
   }
 }
 
+TEST_CASE("hashing", "[owner]")
+{
+  int box = 42;
+  mp::owner<int *> nails{ &box };
+  REQUIRE(std::hash<mp::owner<int *>>{}(nails) == std::hash<int *>{}(&box));
+  REQUIRE(mp::pointer_hash{}(nails) == mp::pointer_hash{}(&box));
+  REQUIRE(mp::pointer_equal{}(nails, &box));
+}
+
 
 // NOLINTEND (cppcoreguidelines-avoid-magic-numbers)
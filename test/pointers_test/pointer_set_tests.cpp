@@ -0,0 +1,255 @@
+#include "hierarchy.hpp"
+#include "marcpawl/pointers/pointer_set.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace mp = marcpawl::pointers;
+
+// NOLINTBEGIN (cppcoreguidelines-avoid-magic-numbers)
+
+namespace {
+// Counts its instances, and throws from a copy once copies_left runs out.
+struct counted
+{
+  static inline int live = 0;
+  static inline int copies_left = 0;
+
+  counted() { ++live; }
+  counted(counted const &)
+  {
+    if (copies_left == 0) { throw std::runtime_error("copy"); }
+    --copies_left;
+    ++live;
+  }
+  counted &operator=(counted const &) = default;
+  ~counted() { --live; }
+};
+}// namespace
+
+TEST_CASE("pointer_set insert", "[pointer_set]")
+{
+  int a = 1;
+  int b = 2;
+  mp::pointer_set<mp::borrower<int *>> set;
+  REQUIRE(set.empty());
+  REQUIRE(set.capacity() == 0);
+
+  auto [position, inserted] = set.insert(mp::make_borrower(&a));
+  REQUIRE(inserted);
+  REQUIRE(*position == mp::make_borrower(&a));
+  REQUIRE(!set.insert(mp::make_borrower(&a)).second);
+  REQUIRE(set.insert(mp::make_borrower(&b)).second);
+  REQUIRE(set.size() == 2);
+}
+
+TEST_CASE("pointer_set null key", "[pointer_set]")
+{
+  mp::pointer_set<mp::borrower<int *>> set;
+  bool exceptionThrown = false;
+  try {
+    set.insert(mp::borrower<int *>(nullptr));
+  } catch (mp::nullptr_exception &) {
+    exceptionThrown = true;
+  }
+  REQUIRE(exceptionThrown);
+  REQUIRE(set.empty());
+  REQUIRE(!set.contains(static_cast<int *>(nullptr)));
+}
+
+TEST_CASE("pointer_set find", "[pointer_set]")
+{
+  Child child;
+  Child other;
+  mp::pointer_set<mp::strict_not_null<Child *>> set{
+    mp::strict_not_null<Child *>(&child)
+  };
+  SECTION("raw pointer")
+  {
+    REQUIRE(set.contains(&child));
+    REQUIRE(set.contains(static_cast<Child const *>(&child)));
+    REQUIRE(!set.contains(&other));
+    REQUIRE(set.find(&other) == set.end());
+  }
+  SECTION("base pointer")
+  {
+    Parent *parent = &child;
+    mp::pointer_set<mp::borrower<Parent *>> parents{ mp::make_borrower(
+      parent) };
+    REQUIRE(parents.contains(&child));
+  }
+  SECTION("wrappers")
+  {
+    REQUIRE(set.contains(mp::make_borrower(&child)));
+    REQUIRE(set.contains(mp::make_maybe_null(&child)));
+    REQUIRE(set.find(mp::strict_not_null<Child *>(&child))->get() == &child);
+  }
+}
+
+TEST_CASE("pointer_set erase", "[pointer_set]")
+{
+  std::vector<int> data(100);
+  mp::pointer_set<mp::borrower<int *>> set;
+  for (auto &d : data) { set.insert(mp::make_borrower(&d)); }
+  REQUIRE(set.size() == data.size());
+
+  for (std::size_t i = 0; i < data.size(); i += 2) {
+    REQUIRE(set.erase(&data[i]) == 1);
+  }
+  REQUIRE(set.erase(&data[0]) == 0);
+  REQUIRE(set.size() == data.size() / 2);
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    REQUIRE(set.contains(&data[i]) == (i % 2 == 1));
+  }
+
+  SECTION("iterator")
+  {
+    for (auto it = set.begin(); it != set.end();) { it = set.erase(it); }
+    REQUIRE(set.empty());
+  }
+  SECTION("reuse")
+  {
+    for (auto &d : data) { set.insert(mp::make_borrower(&d)); }
+    REQUIRE(set.size() == data.size());
+  }
+}
+
+TEST_CASE("pointer_set iteration", "[pointer_set]")
+{
+  std::vector<int> data(1000);
+  mp::pointer_set<mp::borrower<int *>> set(data.size());
+  auto const capacity = set.capacity();
+  for (auto &d : data) { set.insert(mp::make_borrower(&d)); }
+  REQUIRE(set.capacity() == capacity);
+
+  std::unordered_set<int *> seen;
+  for (auto key : set) { seen.insert(key.get()); }
+  REQUIRE(seen.size() == data.size());
+  REQUIRE(seen.contains(&data.front()));
+  REQUIRE(seen.contains(&data.back()));
+}
+
+TEST_CASE("pointer_set copy", "[pointer_set]")
+{
+  int a = 1;
+  int b = 2;
+  mp::pointer_set<mp::borrower<int *>> set{ mp::make_borrower(&a) };
+  auto copy = set;
+  copy.insert(mp::make_borrower(&b));
+  REQUIRE(set.size() == 1);
+  REQUIRE(copy.size() == 2);
+
+  auto moved = std::move(copy);
+  REQUIRE(moved.contains(&b));
+
+  moved.clear();
+  REQUIRE(moved.empty());
+  REQUIRE(!moved.contains(&a));
+}
+
+TEST_CASE("pointer_set strided keys", "[pointer_set]")
+{
+  // Keys a large power of two apart share every low bit of their address.
+  struct page
+  {
+    std::byte data[1024];
+  };
+  std::vector<page> pages(4096);
+  mp::pointer_set<mp::borrower<page *>> set;
+  for (std::size_t i = 0; i < pages.size(); i += 2) {
+    REQUIRE(set.insert(mp::make_borrower(&pages[i])).second);
+  }
+  REQUIRE(set.size() == pages.size() / 2);
+  for (std::size_t i = 0; i < pages.size(); ++i) {
+    REQUIRE(set.contains(&pages[i]) == (i % 2 == 0));
+  }
+  for (std::size_t i = 0; i < pages.size(); i += 4) {
+    REQUIRE(set.erase(&pages[i]) == 1);
+  }
+  REQUIRE(set.size() == pages.size() / 4);
+  for (std::size_t i = 0; i < pages.size(); ++i) {
+    REQUIRE(set.contains(&pages[i]) == (i % 4 == 2));
+  }
+}
+
+TEST_CASE("pointer_map", "[pointer_map]")
+{
+  int a = 1;
+  int b = 2;
+  mp::pointer_map<mp::strict_not_null<int *>, std::string> map;
+  map[mp::strict_not_null<int *>(&a)] = "a";
+  REQUIRE(map.try_emplace(mp::strict_not_null<int *>(&b), "b").second);
+  REQUIRE(!map.try_emplace(mp::strict_not_null<int *>(&b), "c").second);
+  REQUIRE(map.at(&b) == "b");
+
+  map.insert_or_assign(mp::strict_not_null<int *>(&b), "c");
+  REQUIRE(map.at(&b) == "c");
+  REQUIRE(map.find(&a)->second == "a");
+
+  auto const copy = map;
+  map.erase(&a);
+  REQUIRE(!map.contains(&a));
+  REQUIRE(copy.at(&a) == "a");
+
+  bool exceptionThrown = false;
+  try {
+    (void)map.at(&a);
+  } catch (std::out_of_range &) {
+    exceptionThrown = true;
+  }
+  REQUIRE(exceptionThrown);
+}
+
+TEST_CASE("pointer_map values", "[pointer_map]")
+{
+  std::vector<int> data(1000);
+  mp::pointer_map<mp::borrower<int *>, std::unique_ptr<int>> map;
+  for (auto &d : data) {
+    map.try_emplace(mp::make_borrower(&d), std::make_unique<int>(d));
+  }
+  for (std::size_t i = 0; i < data.size(); i += 3) { map.erase(&data[i]); }
+  std::size_t count = 0;
+  for (auto [key, value] : map) {
+    REQUIRE(value != nullptr);
+    ++count;
+  }
+  REQUIRE(count == map.size());
+}
+
+TEST_CASE("pointer_map throwing copies", "[pointer_map]")
+{
+  std::vector<int> data(100);
+  counted::live = 0;
+  counted::copies_left = 1000;
+  {
+    using map_type = mp::pointer_map<mp::borrower<int *>, counted>;
+    map_type map;
+    for (auto &d : data) { map.try_emplace(mp::make_borrower(&d)); }
+    REQUIRE(counted::live == 100);
+
+    SECTION("copy")
+    {
+      counted::copies_left = 50;
+      REQUIRE_THROWS_AS(map_type{ map }, std::runtime_error);
+      REQUIRE(counted::live == 100);
+    }
+    SECTION("rehash")
+    {
+      auto const capacity = map.capacity();
+      counted::copies_left = 50;
+      REQUIRE_THROWS_AS(map.reserve(4 * capacity), std::runtime_error);
+      REQUIRE(counted::live == 100);
+      REQUIRE(map.capacity() == capacity);
+      REQUIRE(map.size() == data.size());
+      for (auto &d : data) { REQUIRE(map.contains(&d)); }
+    }
+  }
+  REQUIRE(counted::live == 0);
+}
+
+// NOLINTEND (cppcoreguidelines-avoid-magic-numbers)
@@ -0,0 +1,147 @@
+#include "marcpawl/pointers/pool.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mp = marcpawl::pointers;
+
+// NOLINTBEGIN (cppcoreguidelines-avoid-magic-numbers)
+
+namespace {
+struct node
+{
+  int value = 0;
+};
+
+struct large
+{
+  std::array<std::uint8_t, 1000> bytes{};
+};
+
+struct throws_on_construction
+{
+  throws_on_construction() { throw std::runtime_error("construction"); }
+};
+
+struct small_pool_tag;
+using small_pool = mp::size_class_pool<small_pool_tag>;
+
+struct threads_tag;
+using threads_pool = mp::size_class_pool<threads_tag>;
+}// namespace
+
+TEST_CASE("pool acquire", "[pool]")
+{
+  using pool = mp::size_class_pool<>;
+  STATIC_REQUIRE(
+    std::is_same_v<decltype(pool::acquire<node>()),
+      mp::owner<mp::strict_not_null<node *>>>);
+
+  auto first = pool::acquire<node>(1);
+  auto second = pool::acquire<node>(2);
+  REQUIRE(first->value == 1);
+  REQUIRE((*second).value == 2);
+  REQUIRE(first.get().get() != second.get().get());
+
+  auto big = pool::acquire<large>();
+  big->bytes[999] = 9;
+  REQUIRE(big->bytes[999] == 9);
+
+  // The last object released is the next one handed out.
+  node *const address = second.get().get();
+  pool::release(std::move(second));
+  auto third = pool::acquire<node>(3);
+  REQUIRE(third.get().get() == address);
+  REQUIRE(third->value == 3);
+
+  pool::release(std::move(first));
+  pool::release(std::move(third));
+  pool::release(std::move(big));
+}
+
+TEST_CASE("pool constructor throws", "[pool]")
+{
+  using pool = mp::size_class_pool<>;
+  auto before = pool::acquire<throws_on_construction *>(nullptr);
+  auto *const address = static_cast<void *>(before.get().get());
+  pool::release(std::move(before));
+
+  bool exceptionThrown = false;
+  try {
+    (void)pool::acquire<throws_on_construction>();
+  } catch (std::runtime_error &) {
+    exceptionThrown = true;
+  }
+  REQUIRE(exceptionThrown);
+
+  // The memory went back to the pool.
+  auto after = pool::acquire<throws_on_construction *>(nullptr);
+  REQUIRE(static_cast<void *>(after.get().get()) == address);
+  pool::release(std::move(after));
+}
+
+TEST_CASE("pool exhausted", "[pool]")
+{
+  small_pool::set_capacity(small_pool::slab_size);
+  std::vector<small_pool::handle<large>> objects;
+  for (;;) {
+    auto object = small_pool::try_acquire<large>();
+    if (!object) { break; }
+    objects.push_back(std::move(*object));
+  }
+  REQUIRE(objects.size() == small_pool::slab_size / 1024 - 1);
+  REQUIRE(small_pool::reserved() == small_pool::slab_size);
+
+  bool exceptionThrown = false;
+  try {
+    (void)small_pool::acquire<large>();
+  } catch (std::bad_alloc &) {
+    exceptionThrown = true;
+  }
+  REQUIRE(exceptionThrown);
+
+  small_pool::release(std::move(objects.back()));
+  objects.pop_back();
+  REQUIRE(small_pool::try_acquire<large>().has_value());
+}
+
+TEST_CASE("pool threads", "[pool]")
+{
+  constexpr std::size_t thread_count = 4;
+  constexpr int rounds = 100;
+  constexpr int objects_per_round = 500;
+  std::vector<std::thread> threads;
+  std::array<bool, thread_count> ok{};
+  for (std::size_t t = 0; t < thread_count; ++t) {
+    threads.emplace_back([t, &ok] {
+      int const first = 1000 * static_cast<int>(t);
+      bool all = true;
+      std::vector<threads_pool::handle<node>> objects;
+      for (int round = 0; round < rounds; ++round) {
+        for (int i = 0; i < objects_per_round; ++i) {
+          objects.push_back(threads_pool::acquire<node>(first + i));
+        }
+        int expected = first;
+        for (auto const &object : objects) {
+          all = all && object->value == expected++;
+        }
+        for (auto &object : objects) { threads_pool::release(std::move(object)); }
+        objects.clear();
+      }
+      ok[t] = all;
+    });
+  }
+  for (auto &thread : threads) { thread.join(); }
+  for (bool const thread_ok : ok) { REQUIRE(thread_ok); }
+}
+
+// NOLINTEND
@@ -0,0 +1,377 @@
+#include "marcpawl/pointers/io.hpp"
+#include "marcpawl/pointers/relative.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define MP_TEST_HAVE_MMAP
+#endif
+
+namespace mp = marcpawl::pointers;
+
+// NOLINTBEGIN (cppcoreguidelines-avoid-magic-numbers)
+
+namespace {
+struct node
+{
+  mp::compressed_ptr<node> next;
+  int value = 0;
+};
+
+struct list_node
+{
+  int value = 0;
+  mp::maybe_null<mp::compressed_ptr<list_node>> next;
+};
+
+struct borrowing_node
+{
+  int value = 0;
+  mp::borrower<mp::compressed_ptr<borrowing_node>> next;
+};
+
+struct pinned_node
+{
+  int value = 0;
+  mp::strict_not_null<mp::compressed_ptr<int>> target;
+};
+
+struct tree_node
+{
+  mp::maybe_null<mp::self_relative<tree_node>> left;
+  mp::maybe_null<mp::self_relative<tree_node>> right;
+  std::uint64_t value = 0;
+};
+
+// A complete binary tree of count nodes built in region, node i has the
+// children 2i+1 and 2i+2.
+tree_node *build_tree(std::byte *region, std::size_t count)
+{
+  auto *const nodes = reinterpret_cast<tree_node *>(region);
+  for (std::size_t i = 0; i < count; ++i) {
+    new (&nodes[i]) tree_node{};
+    nodes[i].value = i;
+  }
+  for (std::size_t i = 0; i < count; ++i) {
+    if (2 * i + 1 < count) {
+      nodes[i].left = mp::maybe_null<mp::self_relative<tree_node>>{
+        &nodes[2 * i + 1]
+      };
+    }
+    if (2 * i + 2 < count) {
+      nodes[i].right = mp::maybe_null<mp::self_relative<tree_node>>{
+        &nodes[2 * i + 2]
+      };
+    }
+  }
+  return nodes;
+}
+
+std::uint64_t tree_sum(mp::maybe_null<mp::self_relative<tree_node>> const &n)
+{
+  return n.visit([](std::nullptr_t) { return std::uint64_t{ 0 }; },
+    [](mp::strict_not_null<tree_node *> p) {
+      return p->value + tree_sum(p->left) + tree_sum(p->right);
+    });
+}
+
+std::uint64_t tree_sum(tree_node const &root)
+{
+  return root.value + tree_sum(root.left) + tree_sum(root.right);
+}
+
+// The arena that offset_ptr<T, arena> is relative to.
+struct arena
+{
+  static inline std::array<std::uint64_t, 16> storage{};
+  static void const *base() noexcept { return storage.data(); }
+};
+}// namespace
+
+TEST_CASE("relative size", "[relative]")
+{
+  STATIC_REQUIRE(sizeof(mp::compressed_ptr<node>) == 4);
+  STATIC_REQUIRE(sizeof(mp::offset_ptr<std::uint64_t, arena>) == 4);
+  STATIC_REQUIRE(sizeof(mp::maybe_null<mp::compressed_ptr<node>>) == 4);
+  STATIC_REQUIRE(sizeof(mp::borrower<mp::offset_ptr<std::uint64_t, arena>>) == 4);
+  STATIC_REQUIRE(
+    std::is_trivially_copyable_v<mp::offset_ptr<std::uint64_t, arena>>);
+  STATIC_REQUIRE(!std::is_trivially_copyable_v<mp::compressed_ptr<node>>);
+}
+
+TEST_CASE("compressed_ptr", "[relative]")
+{
+  node n{ nullptr, 42 };
+  mp::compressed_ptr<node> p;
+  REQUIRE(p == nullptr);
+  REQUIRE(p.get() == nullptr);
+  REQUIRE(!p);
+
+  p = &n;
+  REQUIRE(p != nullptr);
+  REQUIRE(p.get() == &n);
+  REQUIRE(p->value == 42);
+  REQUIRE((*p).value == 42);
+
+  // A copy elsewhere still points at the same node.
+  std::array<mp::compressed_ptr<node>, 2> copies{ p, p };
+  REQUIRE(copies[1].get() == &n);
+  REQUIRE(copies[1] == p);
+
+  p = nullptr;
+  REQUIRE(p == nullptr);
+}
+
+TEST_CASE("compressed_ptr to its holder", "[relative]")
+{
+  node n{ nullptr, 1 };
+  n.next = &n;
+  REQUIRE(n.next != nullptr);
+  REQUIRE(n.next.get() == &n);
+}
+
+TEST_CASE("compressed_ptr follows a copy of the whole block", "[relative]")
+{
+  std::vector<node> nodes(3);
+  for (std::size_t i = 0; i < nodes.size(); ++i) {
+    nodes[i].value = static_cast<int>(i);
+    nodes[i].next = &nodes[(i + 1) % nodes.size()];
+  }
+  std::vector<node> copy = nodes;
+  REQUIRE(copy[0].next.get() == &nodes[1]);
+
+  // Copying the bytes moves the targets along with the pointers.
+  std::vector<std::byte> bytes(sizeof(node) * nodes.size());
+  std::memcpy(bytes.data(), nodes.data(), bytes.size());
+  auto const *moved = reinterpret_cast<node const *>(bytes.data());
+  REQUIRE(moved[0].next.get() == &moved[1]);
+  REQUIRE(moved[2].next->value == 0);
+}
+
+TEST_CASE("offset_ptr", "[relative]")
+{
+  using ptr = mp::offset_ptr<std::uint64_t, arena>;
+  ptr p;
+  REQUIRE(p == nullptr);
+  REQUIRE(p.offset() == 0);
+
+  arena::storage[0] = 10;
+  arena::storage[3] = 13;
+  p = &arena::storage[0];
+  REQUIRE(p != nullptr);
+  REQUIRE(p.offset() == 1);
+  REQUIRE(*p == 10);
+
+  ptr q = &arena::storage[3];
+  REQUIRE(*q == 13);
+  REQUIRE(p < q);
+  REQUIRE(p != q);
+  REQUIRE(ptr{ &arena::storage[3] } == q);
+}
+
+TEST_CASE("offset_ptr outside of the arena", "[relative]")
+{
+  struct upper_half
+  {
+    static void const *base() noexcept { return &arena::storage[8]; }
+  };
+  bool exceptionThrown = false;
+  try {
+    mp::offset_ptr<std::uint64_t, upper_half> p{ &arena::storage[0] };
+    (void)p;
+  } catch (std::out_of_range &) {
+    exceptionThrown = true;
+  }
+  REQUIRE(exceptionThrown);
+}
+
+TEST_CASE("relative pointers in wrappers", "[relative]")
+{
+  node last{ nullptr, 2 };
+  node first{ &last, 1 };
+
+  mp::maybe_null<mp::compressed_ptr<node>> maybe{ &first };
+  int const value = maybe.visit([](std::nullptr_t) { return 0; },
+    [](mp::strict_not_null<node *> p) {
+      return p->value + p->next->value;
+    });
+  REQUIRE(value == 3);
+
+  mp::maybe_null<mp::compressed_ptr<node>> none{ nullptr };
+  REQUIRE(none.visit([](std::nullptr_t) { return true; },
+    [](mp::strict_not_null<node *>) { return false; }));
+
+  mp::strict_not_null<mp::compressed_ptr<node>> not_null{ &last };
+  REQUIRE(not_null->value == 2);
+  REQUIRE((*not_null).value == 2);
+
+  mp::borrower<mp::compressed_ptr<node>> borrowed{ &first };
+  REQUIRE(borrowed != nullptr);
+  REQUIRE(borrowed->next->value == 2);
+
+  mp::borrower<mp::offset_ptr<std::uint64_t, arena>> in_arena{
+    &arena::storage[5]
+  };
+  arena::storage[5] = 55;
+  REQUIRE(*in_arena == 55);
+}
+
+TEST_CASE("maybe_null of compressed_ptr on the heap", "[relative]")
+{
+  // Far from the stack, where a copy of the pointer could not reach them.
+  auto first = std::make_unique<list_node>();
+  auto second = std::make_unique<list_node>();
+  first->value = 1;
+  second->value = 2;
+
+  first->next = second.get();
+  REQUIRE(first->next == second.get());
+  second->next = mp::maybe_null<list_node *>(first.get());
+  REQUIRE(second->next == first.get());
+  first->next = second->next;
+  REQUIRE(first->next == first.get());
+  first->next = second.get();
+
+  auto const value = [](mp::strict_not_null<list_node *> n) {
+    return n->value;
+  };
+  REQUIRE(first->next.visit([](std::nullptr_t) { return 0; }, value) == 2);
+  REQUIRE(first->next.as_optional_not_null().value().get() == second.get());
+  REQUIRE(mp::get<1>(first->next.as_variant_not_null()) == second.get());
+  REQUIRE(first->next.transform(value) == std::optional<int>(2));
+  REQUIRE(first->next.then(&list_node::next).transform(value)
+          == std::optional<int>(1));
+  REQUIRE(first->next.value_or(mp::strict_not_null(first.get())).get()
+          == second.get());
+
+  second->next = mp::maybe_null<list_node *>();
+  REQUIRE(!second->next.as_optional_not_null().has_value());
+  REQUIRE(second->next.visit([](std::nullptr_t) { return 0; }, value) == 0);
+}
+
+TEST_CASE("borrower and strict_not_null of compressed_ptr on the heap",
+  "[relative]")
+{
+  auto first = std::make_unique<borrowing_node>();
+  auto second = std::make_unique<borrowing_node>();
+  first->value = 1;
+  second->value = 2;
+
+  // A borrower built on the stack cannot reach the heap.
+  REQUIRE_THROWS_AS(first->next = mp::borrower<mp::compressed_ptr<
+                      borrowing_node>>(second.get()),
+    std::out_of_range);
+
+  first->next = second.get();
+  REQUIRE(first->next->value == 2);
+  second->next = first.get();
+  REQUIRE(second->next->value == 1);
+  first->next = first.get();
+  REQUIRE(first->next->value == 1);
+
+  auto const targets = std::make_unique<std::array<int, 2>>();
+  (*targets)[0] = 10;
+  (*targets)[1] = 20;
+  // Built in place, where the target is in reach.
+  std::unique_ptr<pinned_node> const pinned(new pinned_node{ 1,
+    mp::strict_not_null<mp::compressed_ptr<int>>(targets->data()) });
+  REQUIRE(*pinned->target == 10);
+
+  pinned->target.reset(&(*targets)[1]);
+  REQUIRE(*pinned->target == 20);
+
+  int *const null = nullptr;
+  REQUIRE_THROWS_AS(pinned->target.reset(null), mp::nullptr_exception);
+  REQUIRE(*pinned->target == 20);
+}
+
+// Only a self relative pointer is assigned from a raw pointer, the others are
+// built explicitly.
+static_assert(
+  std::is_assignable_v<mp::maybe_null<mp::compressed_ptr<list_node>> &,
+    list_node *>);
+static_assert(!std::is_assignable_v<mp::maybe_null<int *> &, int *>);
+static_assert(
+  std::is_assignable_v<mp::borrower<mp::compressed_ptr<borrowing_node>> &,
+    borrowing_node *>);
+static_assert(!std::is_assignable_v<mp::borrower<int *> &, int *>);
+
+TEST_CASE("relative pointers printed", "[relative]")
+{
+  node n{ nullptr, 1 };
+  mp::compressed_ptr<node> const compressed{ &n };
+  mp::offset_ptr<std::uint64_t, arena> const offset{ &arena::storage[2] };
+  mp::maybe_null<mp::compressed_ptr<node>> const wrapped{ &n };
+
+  std::ostringstream printed;
+  std::ostringstream expected;
+  printed << compressed << ' ' << offset << ' ' << wrapped;
+  expected << &n << ' ' << &arena::storage[2] << ' ' << &n;
+  REQUIRE(printed.str() == expected.str());
+}
+
+TEST_CASE("self_relative tree mapped from a file", "[relative]")
+{
+  constexpr std::size_t count = 1000;
+  constexpr std::uint64_t expected = count * (count - 1) / 2;
+  constexpr std::size_t size = count * sizeof(tree_node);
+
+  std::vector<tree_node> built(count);
+  build_tree(reinterpret_cast<std::byte *>(built.data()), count);
+  REQUIRE(tree_sum(built[0]) == expected);
+
+  auto const path = std::filesystem::temp_directory_path()
+                    / "marcpawl_pointers_self_relative.bin";
+  {
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<char const *>(built.data()),
+      static_cast<std::streamsize>(size));
+  }
+
+  SECTION("read into a buffer")
+  {
+    std::vector<tree_node> loaded(count);
+    std::ifstream in(path, std::ios::binary);
+    in.read(
+      reinterpret_cast<char *>(loaded.data()), static_cast<std::streamsize>(size));
+    REQUIRE(in.good());
+    REQUIRE(loaded[0].left.visit([](std::nullptr_t) { return false; },
+      [&](auto p) { return &*p == &loaded[1]; }));
+    REQUIRE(tree_sum(loaded[0]) == expected);
+  }
+
+#if defined(MP_TEST_HAVE_MMAP)
+  SECTION("mapped")
+  {
+    int const fd = ::open(path.c_str(), O_RDONLY);
+    REQUIRE(fd >= 0);
+    void *const mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    REQUIRE(mapped != MAP_FAILED);
+    auto const *root = static_cast<tree_node const *>(mapped);
+    REQUIRE(root != built.data());
+    REQUIRE(tree_sum(*root) == expected);
+    ::munmap(mapped, size);
+  }
+#endif
+
+  std::filesystem::remove(path);
+}
+
+// NOLINTEND
@@ -0,0 +1,114 @@
+#include "hierarchy.hpp"
+#include "marcpawl/pointers/tagged.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+namespace mp = marcpawl::pointers;
+
+// NOLINTBEGIN (cppcoreguidelines-avoid-magic-numbers)
+
+namespace {
+struct alignas(16) node
+{
+  int value = 0;
+};
+}// namespace
+
+TEST_CASE("tagged size", "[tagged]")
+{
+  using edge = mp::tagged<mp::borrower<node *>>;
+  STATIC_REQUIRE(edge::tag_bits == 4);
+  STATIC_REQUIRE(mp::tagged<mp::borrower<std::int32_t *>>::tag_bits == 2);
+  STATIC_REQUIRE(mp::tagged<mp::borrower<char *>>::tag_bits == 0);
+  STATIC_REQUIRE(sizeof(edge) == sizeof(node *));
+  STATIC_REQUIRE(std::is_trivially_copyable_v<edge>);
+}
+
+TEST_CASE("tagged get", "[tagged]")
+{
+  node n{ 42 };
+  mp::tagged<mp::borrower<node *>, 2> edge{ mp::make_borrower(&n), 3 };
+  REQUIRE(edge.get() == &n);
+  REQUIRE(edge.tag() == 3);
+  REQUIRE(edge->value == 42);
+  REQUIRE((*edge).value == 42);
+  REQUIRE(edge.untagged() == mp::make_borrower(&n));
+
+  edge.set_tag(1);
+  REQUIRE(edge.tag() == 1);
+  REQUIRE(edge.get() == &n);
+
+  node other{ 7 };
+  edge.assign(mp::make_borrower(&other));
+  REQUIRE(edge.tag() == 1);
+  REQUIRE(edge->value == 7);
+}
+
+TEST_CASE("tagged tag too large", "[tagged]")
+{
+  node n;
+  mp::tagged<mp::borrower<node *>, 1> edge{ mp::make_borrower(&n) };
+  bool exceptionThrown = false;
+  try {
+    edge.set_tag(2);
+  } catch (std::out_of_range &) {
+    exceptionThrown = true;
+  }
+  REQUIRE(exceptionThrown);
+  REQUIRE(edge.tag() == 0);
+}
+
+TEST_CASE("tagged maybe_null", "[tagged]")
+{
+  SECTION("nullptr")
+  {
+    mp::tagged<mp::maybe_null<node *>> edge{ mp::maybe_null<node *>{}, 5 };
+    REQUIRE(edge.tag() == 5);
+    REQUIRE(!edge.as_optional_not_null().has_value());
+    auto const value = edge.visit([](std::nullptr_t) { return -1; },
+      [](mp::strict_not_null<node *> p) { return p->value; });
+    REQUIRE(value == -1);
+  }
+  SECTION("not nullptr")
+  {
+    node n{ 42 };
+    mp::tagged<mp::maybe_null<node *>> edge{ mp::make_maybe_null(&n), 15 };
+    auto const value = edge.visit([](std::nullptr_t) { return -1; },
+      [](mp::strict_not_null<node *> p) { return p->value; });
+    REQUIRE(value == 42);
+  }
+  SECTION("likelihood")
+  {
+    node n{ 42 };
+    mp::tagged<mp::maybe_null<node *>> edge{ mp::make_maybe_null(&n), 15 };
+    auto const value = edge.visit<mp::likely_not_null>(
+      [](std::nullptr_t) { return -1; },
+      [](mp::strict_not_null<node *> p) { return p->value; });
+    REQUIRE(value == 42);
+    REQUIRE(edge.as_optional_not_null<mp::likely_null>().has_value());
+  }
+}
+
+TEST_CASE("tagged strict_not_null", "[tagged]")
+{
+  Child child;
+  mp::tagged<mp::strict_not_null<Child *>, 1> edge{
+    mp::strict_not_null<Child *>(&child), 1
+  };
+  mp::strict_not_null<Child *> const untagged = edge.untagged();
+  REQUIRE(untagged.get() == &child);
+  REQUIRE(edge->value == child.value);
+}
+
+TEST_CASE("tagged comparison", "[tagged]")
+{
+  node n;
+  using edge = mp::tagged<mp::borrower<node *>>;
+  REQUIRE(edge{ mp::make_borrower(&n), 1 } == edge{ mp::make_borrower(&n), 1 });
+  REQUIRE(edge{ mp::make_borrower(&n), 1 } != edge{ mp::make_borrower(&n), 2 });
+}
+
+// NOLINTEND (cppcoreguidelines-avoid-magic-numbers)
@@ -0,0 +1,109 @@
+#include "marcpawl/pointers/ptr.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <type_traits>
+#include <variant>
+
+namespace mp = marcpawl::pointers;
+
+// NOLINTBEGIN (cppcoreguidelines-avoid-magic-numbers)
+
+namespace {
+constexpr int constant_data = 3;
+
+template<typename... F> struct overloaded : F...
+{
+  using F::operator()...;
+};
+}// namespace
+
+TEST_CASE("variant_not_null layout", "[variant_not_null]")
+{
+  using variant = mp::variant_not_null<int *>;
+  STATIC_REQUIRE(sizeof(variant) == sizeof(int *));
+  STATIC_REQUIRE(std::is_trivially_copyable_v<variant>);
+  STATIC_REQUIRE(
+    std::is_same_v<mp::maybe_null<int *>::variant_not_null, variant>);
+  STATIC_REQUIRE(
+    std::is_same_v<mp::maybe_null<std::unique_ptr<int>>::variant_not_null,
+      std::variant<std::nullptr_t,
+        mp::strict_not_null<std::unique_ptr<int>>>>);
+  STATIC_REQUIRE(std::variant_size_v<variant> == 2);
+  STATIC_REQUIRE(
+    std::is_same_v<std::variant_alternative_t<1, variant>,
+      mp::strict_not_null<int *>>);
+}
+
+TEST_CASE("variant_not_null alternatives", "[variant_not_null]")
+{
+  int data = 3;
+  mp::variant_not_null<int *> const none;
+  mp::variant_not_null<int *> const some = mp::strict_not_null(&data);
+
+  REQUIRE(none.index() == 0);
+  REQUIRE(some.index() == 1);
+  REQUIRE(!some.valueless_by_exception());
+  REQUIRE(mp::holds_alternative<std::nullptr_t>(none));
+  REQUIRE(holds_alternative<mp::strict_not_null<int *>>(some));
+
+  REQUIRE(mp::get<0>(none) == nullptr);
+  REQUIRE(mp::get<1>(some).get() == &data);
+  REQUIRE_THROWS_AS(mp::get<1>(none), std::bad_variant_access);
+  REQUIRE_THROWS_AS(mp::get<std::nullptr_t>(some), std::bad_variant_access);
+
+  REQUIRE(mp::get_if<0>(&none) != nullptr);
+  REQUIRE(mp::get_if<1>(&none) == nullptr);
+  auto const *const alternative =
+    mp::get_if<mp::strict_not_null<int *>>(&some);
+  REQUIRE(alternative != nullptr);
+  REQUIRE(alternative->get() == &data);
+  REQUIRE(mp::get_if<1>(
+            static_cast<mp::variant_not_null<int *> const *>(nullptr))
+          == nullptr);
+
+  REQUIRE(none != some);
+  REQUIRE(some == mp::variant_not_null<int *>(mp::strict_not_null(&data)));
+}
+
+TEST_CASE("variant_not_null visit", "[variant_not_null]")
+{
+  int data = 3;
+  mp::maybe_null<int *> const null;
+  mp::maybe_null<int *> const some(&data);
+  auto const visitor = overloaded{ [](std::nullptr_t) { return -1; },
+    [](mp::strict_not_null<int *> p) { return *p; } };
+
+  REQUIRE(visit(visitor, null.as_variant_not_null()) == -1);
+  REQUIRE(mp::visit(visitor, some.as_variant_not_null()) == 3);
+  REQUIRE(some.as_variant_not_null().visit(visitor) == 3);
+}
+
+TEST_CASE("variant_not_null and std::variant", "[variant_not_null]")
+{
+  int data = 3;
+  mp::variant_not_null<int *> const some = mp::strict_not_null(&data);
+  std::variant<std::nullptr_t, mp::strict_not_null<int *>> const standard =
+    some;
+  REQUIRE(standard.index() == 1);
+  REQUIRE(std::get<1>(standard).get() == &data);
+
+  mp::variant_not_null<int *> const back = standard;
+  REQUIRE(back == some);
+  mp::variant_not_null<int const *> const to_const = back;
+  REQUIRE(mp::get<1>(to_const).get() == &data);
+
+  std::variant<std::nullptr_t, mp::strict_not_null<int *>> const null;
+  REQUIRE(mp::variant_not_null<int *>(null).index() == 0);
+}
+
+TEST_CASE("variant_not_null in constant expressions", "[variant_not_null]")
+{
+  constexpr mp::variant_not_null<int const *> some =
+    mp::constant_not_null(&constant_data);
+  STATIC_REQUIRE(some.index() == 1);
+  STATIC_REQUIRE(*mp::get<1>(some) == 3);
+  STATIC_REQUIRE(mp::variant_not_null<int const *>{}.index() == 0);
+}
+
+// NOLINTEND